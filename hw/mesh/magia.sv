@@ -226,7 +226,7 @@ module magia
       );
   `ifdef CORE_TRACES
       localparam string core_trace_file_name = $sformatf("%s%0d", "log_file_", i*N_TILES_X+j);
-      defparam i_magia_tile.i_cv32e40x_core.rvfi_i.tracer_i.LOGFILE_PATH_PLUSARG = core_trace_file_name;
+      defparam i_magia_tile.gen_core[0].i_cv32e40x_core.rvfi_i.tracer_i.LOGFILE_PATH_PLUSARG = core_trace_file_name;
   `endif
 
       if (i == 0) begin
@@ -22,13 +22,15 @@
 module cache2instr_rsp 
   import magia_tile_pkg::*;
 (
-  input  magia_tile_pkg::core_cache_instr_rsp_t cache_rsp_i,
-  output magia_tile_pkg::core_instr_rsp_t       instr_rsp_o
+  input  magia_tile_pkg::core_cache_instr_rsp_t                               cache_rsp_i,
+  output magia_tile_pkg::core_instr_rsp_t[magia_tile_pkg::NR_FETCH_PORTS-1:0] instr_rsp_o
 );
 
-  assign instr_rsp_o.gnt    = cache_rsp_i.gnt;
-  assign instr_rsp_o.rvalid = cache_rsp_i.rvalid;
-  assign instr_rsp_o.rdata  = cache_rsp_i.rdata;
-  assign instr_rsp_o.err    = cache_rsp_i.rerror;
+  for (genvar i = 0; i < magia_tile_pkg::NR_FETCH_PORTS; i++) begin: gen_fetch_port
+    assign instr_rsp_o[i].gnt    = cache_rsp_i.gnt[i];
+    assign instr_rsp_o[i].rvalid = cache_rsp_i.rvalid[i];
+    assign instr_rsp_o[i].rdata  = cache_rsp_i.rdata[i];
+    assign instr_rsp_o[i].err    = cache_rsp_i.rerror[i];
+  end
 
 endmodule: cache2instr_rsp
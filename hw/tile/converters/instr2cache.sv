@@ -22,11 +22,13 @@
 module instr2cache_req 
   import magia_tile_pkg::*;
 (
-  input  magia_tile_pkg::core_instr_req_t       instr_req_i,
-  output magia_tile_pkg::core_cache_instr_req_t cache_req_o
+  input  magia_tile_pkg::core_instr_req_t[magia_tile_pkg::NR_FETCH_PORTS-1:0] instr_req_i,
+  output magia_tile_pkg::core_cache_instr_req_t                               cache_req_o
 );
   
-  assign cache_req_o.req  = instr_req_i.req;
-  assign cache_req_o.addr = instr_req_i.addr;
+  for (genvar i = 0; i < magia_tile_pkg::NR_FETCH_PORTS; i++) begin: gen_fetch_port
+    assign cache_req_o.req[i]  = instr_req_i[i].req;
+    assign cache_req_o.addr[i] = instr_req_i[i].addr;
+  end
   
 endmodule: instr2cache_req
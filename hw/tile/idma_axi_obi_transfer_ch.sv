@@ -17,6 +17,11 @@
  * Authors: Victor Isachi <victor.isachi@unibo.it>
  * 
  * iDMA AXI-OBI Transfer Channel
+ *
+ * MAX_OUTSTANDING bounds the jobs issued on the frontend and not yet retired by the
+ * mid-end: they fill the job FIFO while the back-end keeps up to NUM_AX_IN_FLIGHT
+ * bursts in flight, so the AXI latency of a job overlaps with the previous ones.
+ * Jobs retire in issue order, DONE_ID is the last ID retired.
  */
 
 module idma_axi_obi_transfer_ch 
@@ -26,6 +31,8 @@ module idma_axi_obi_transfer_ch
 #(
   parameter magia_tile_pkg::idma_transfer_ch_e CHANNEL_T         = magia_tile_pkg::AXI2OBI,
   parameter idma_pkg::error_cap_e              ERROR_CAP         = idma_pkg::NO_ERROR_HANDLING,
+  parameter int unsigned                       MAX_OUTSTANDING   = magia_tile_pkg::iDMA_MaxOutstanding,
+  parameter int unsigned                       NUM_AX_IN_FLIGHT  = magia_tile_pkg::iDMA_NumAxInFlight,
   parameter type                               idma_fe_reg_req_t = magia_tile_pkg::idma_fe_reg_req_t,
   parameter type                               idma_fe_reg_rsp_t = magia_tile_pkg::idma_fe_reg_rsp_t,
   parameter type                               axi_req_t         = magia_tile_pkg::idma_axi_req_t,
@@ -65,6 +72,7 @@ module idma_axi_obi_transfer_ch
   magia_tile_pkg::idma_be_rsp_t idma_be_rsp;
 
   logic fe_req_valid_d, fe_req_ready_d;
+  logic fifo_valid_in,  fifo_ready_in;
   logic fe_req_valid,   fe_req_ready;
   logic fe_rsp_valid,   fe_rsp_ready;
   logic be_req_valid,   be_req_ready;
@@ -73,6 +81,11 @@ module idma_axi_obi_transfer_ch
   logic                                          issue_id, retire_id;
   logic[magia_tile_pkg::iDMA_IdCounterWidth-1:0] next_id,  done_id;
 
+  localparam int unsigned OutstandingWidth = $clog2(MAX_OUTSTANDING+1);
+
+  logic[OutstandingWidth-1:0] outstanding_q, outstanding_d;
+  logic                       outstanding_full;
+
   logic stream_fifo_flush;
 
   idma_pkg::idma_busy_t busy;
@@ -97,6 +110,11 @@ module idma_axi_obi_transfer_ch
 
   assign stream_fifo_flush = 1'b0;
 
+  // A job is only accepted while fewer than MAX_OUTSTANDING are in flight
+  assign outstanding_full = (outstanding_q == MAX_OUTSTANDING);
+  assign fifo_valid_in    = fe_req_valid_d & ~outstanding_full;
+  assign fe_req_ready_d   = fifo_ready_in  & ~outstanding_full;
+
 /*******************************************************/
 /**               Hardwired Signals End               **/
 /*******************************************************/
@@ -148,6 +166,20 @@ module idma_axi_obi_transfer_ch
     .completed_o ( done_id   )
   );
 
+  always_comb begin: outstanding_counter
+    outstanding_d = outstanding_q;
+    case ({issue_id, retire_id})
+      2'b10:   outstanding_d = outstanding_q + 1;
+      2'b01:   outstanding_d = outstanding_q - 1;
+      default: outstanding_d = outstanding_q;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: outstanding_counter_ff
+    if (!rst_ni) outstanding_q <= '0;
+    else         outstanding_q <= outstanding_d;
+  end
+
 /*******************************************************/
 /**                  Transfer ID End                  **/
 /*******************************************************/
@@ -155,7 +187,7 @@ module idma_axi_obi_transfer_ch
 /*******************************************************/
 
   stream_fifo_optimal_wrap #(
-    .Depth     ( magia_tile_pkg::iDMA_JobFifoDepth  ),
+    .Depth     ( MAX_OUTSTANDING                    ),
     .type_t    ( magia_tile_pkg::idma_nd_req_t      ),
     .PrintInfo ( magia_tile_pkg::iDMA_PrintFifoInfo )
   ) i_stream_fifo_jobs_2d (
@@ -165,8 +197,8 @@ module idma_axi_obi_transfer_ch
     .flush_i    ( stream_fifo_flush ),
     .usage_o    (                   ),
     .data_i     ( idma_fe_req_d     ),
-    .valid_i    ( fe_req_valid_d    ),
-    .ready_o    ( fe_req_ready_d    ),
+    .valid_i    ( fifo_valid_in     ),
+    .ready_o    ( fifo_ready_in     ),
     .data_o     ( idma_fe_req       ),
     .valid_o    ( fe_req_valid      ),
     .ready_i    ( fe_req_ready      )
@@ -220,7 +252,7 @@ module idma_axi_obi_transfer_ch
       .AddrWidth            ( magia_tile_pkg::iDMA_AddrWidth            ),
       .UserWidth            ( magia_tile_pkg::iDMA_UserWidth            ),
       .AxiIdWidth           ( magia_tile_pkg::iDMA_AxiIdWidth           ),
-      .NumAxInFlight        ( magia_tile_pkg::iDMA_NumAxInFlight        ),
+      .NumAxInFlight        ( NUM_AX_IN_FLIGHT                          ),
       .BufferDepth          ( magia_tile_pkg::iDMA_BufferDepth          ),
       .TFLenWidth           ( magia_tile_pkg::iDMA_TFLenWidth           ),
       .MemSysDepth          ( magia_tile_pkg::iDMA_MemSysDepth          ),
@@ -274,7 +306,7 @@ module idma_axi_obi_transfer_ch
       .AddrWidth            ( magia_tile_pkg::iDMA_AddrWidth            ),
       .UserWidth            ( magia_tile_pkg::iDMA_UserWidth            ),
       .AxiIdWidth           ( magia_tile_pkg::iDMA_AxiIdWidth           ),
-      .NumAxInFlight        ( magia_tile_pkg::iDMA_NumAxInFlight        ),
+      .NumAxInFlight        ( NUM_AX_IN_FLIGHT                          ),
       .BufferDepth          ( magia_tile_pkg::iDMA_BufferDepth          ),
       .TFLenWidth           ( magia_tile_pkg::iDMA_TFLenWidth           ),
       .MemSysDepth          ( magia_tile_pkg::iDMA_MemSysDepth          ),
@@ -23,6 +23,11 @@
  * with interrupt support. It wraps both AXI2OBI and OBI2AXI transfer channels
  * along with the memory-mapped bridge, providing equivalent functionality
  * to idma_ctrl but using memory-mapped register access instead of ISA extensions.
+ * Each channel also has a descriptor chain walker (idma_desc_chain) that programs
+ * the channel from a linked list of descriptors fetched from L1, and a completion
+ * coalescer (idma_done_coalesce) that merges its done pulses into fewer events.
+ * An L1 data transform (idma_obi_xform) on the OBI port of each channel adds fill
+ * and FP conversion modes to the transfers.
  */
 
 module idma_ctrl_mm
@@ -30,6 +35,8 @@ module idma_ctrl_mm
   import idma_pkg::*;
 #(
   parameter int unsigned ERROR_CAP = 3,
+  parameter int unsigned MAX_OUTSTANDING  = magia_tile_pkg::iDMA_MaxOutstanding,
+  parameter int unsigned NUM_AX_IN_FLIGHT = magia_tile_pkg::iDMA_NumAxInFlight,
   parameter type obi_req_t = magia_tile_pkg::core_obi_data_req_t,
   parameter type obi_rsp_t = magia_tile_pkg::core_obi_data_rsp_t,
   parameter type idma_fe_reg_req_t = magia_tile_pkg::idma_fe_reg_req_t,
@@ -60,6 +67,12 @@ module idma_ctrl_mm
   output idma_obi_req_t obi_write_req_o,  // AXI2OBI: L1 write
   input  idma_obi_rsp_t obi_write_rsp_i,
 
+  // OBI Master Interfaces (descriptor fetch from L1)
+  output obi_req_t     desc_a2o_obi_req_o,
+  input  obi_rsp_t     desc_a2o_obi_rsp_i,
+  output obi_req_t     desc_o2a_obi_req_o,
+  input  obi_rsp_t     desc_o2a_obi_rsp_i,
+
   // Serialized IRQ outputs
   output logic         irq_a2o_busy_o,
   output logic         irq_a2o_start_o,
@@ -68,7 +81,9 @@ module idma_ctrl_mm
   output logic         irq_o2a_busy_o,
   output logic         irq_o2a_start_o,
   output logic         irq_o2a_done_o,
-  output logic         irq_o2a_error_o
+  output logic         irq_o2a_error_o,
+  output logic         irq_a2o_chain_done_o,
+  output logic         irq_o2a_chain_done_o
 );
 
 /*******************************************************/
@@ -81,6 +96,42 @@ module idma_ctrl_mm
   idma_fe_reg_req_t idma_fe_reg_obi2axi_req; 
   idma_fe_reg_rsp_t idma_fe_reg_obi2axi_rsp;
 
+  // Register frontend requests from the core (through the decoder)
+  idma_fe_reg_req_t core_axi2obi_req;
+  idma_fe_reg_rsp_t core_axi2obi_rsp;
+  idma_fe_reg_req_t core_obi2axi_req;
+  idma_fe_reg_rsp_t core_obi2axi_rsp;
+
+  // Register frontend requests from the descriptor chain walkers
+  idma_fe_reg_req_t chain_axi2obi_fe_req;
+  idma_fe_reg_rsp_t chain_axi2obi_fe_rsp;
+  idma_fe_reg_req_t chain_obi2axi_fe_req;
+  idma_fe_reg_rsp_t chain_obi2axi_fe_rsp;
+
+  // Chain registers (from the decoder)
+  idma_fe_reg_req_t chain_axi2obi_req;
+  idma_fe_reg_rsp_t chain_axi2obi_rsp;
+  idma_fe_reg_req_t chain_obi2axi_req;
+  idma_fe_reg_rsp_t chain_obi2axi_rsp;
+
+  // Completion coalescing registers (from the decoder)
+  idma_fe_reg_req_t coal_axi2obi_req;
+  idma_fe_reg_rsp_t coal_axi2obi_rsp;
+  idma_fe_reg_req_t coal_obi2axi_req;
+  idma_fe_reg_rsp_t coal_obi2axi_rsp;
+
+  // L1 data transform registers (from the decoder)
+  idma_fe_reg_req_t xform_axi2obi_req;
+  idma_fe_reg_rsp_t xform_axi2obi_rsp;
+  idma_fe_reg_req_t xform_obi2axi_req;
+  idma_fe_reg_rsp_t xform_obi2axi_rsp;
+
+  // L1 ports of the transfer channels, before the data transform
+  idma_obi_req_t ch_obi_write_req;
+  idma_obi_rsp_t ch_obi_write_rsp;
+  idma_obi_req_t ch_obi_read_req;
+  idma_obi_rsp_t ch_obi_read_rsp;
+
   // Direct transfer channel IRQ signals (used for IRQ logic)
   logic a2o_transfer_busy;
   logic a2o_transfer_start;
@@ -99,6 +150,8 @@ module idma_ctrl_mm
   idma_axi_obi_transfer_ch #(
     .CHANNEL_T         ( magia_tile_pkg::AXI2OBI           ),
     .ERROR_CAP         ( ERROR_CAP                         ),
+    .MAX_OUTSTANDING   ( MAX_OUTSTANDING                   ),
+    .NUM_AX_IN_FLIGHT  ( NUM_AX_IN_FLIGHT                  ),
     .idma_fe_reg_req_t ( magia_tile_pkg::idma_fe_reg_req_t ),
     .idma_fe_reg_rsp_t ( magia_tile_pkg::idma_fe_reg_rsp_t ),
     .axi_req_t         ( magia_tile_pkg::idma_axi_req_t    ),
@@ -114,8 +167,8 @@ module idma_ctrl_mm
     .cfg_rsp_o        ( idma_fe_reg_axi2obi_rsp         ),
     .axi_req_o        ( axi_read_req_o                  ),
     .axi_rsp_i        ( axi_read_rsp_i                  ),
-    .obi_req_o        ( obi_write_req_o                 ),
-    .obi_rsp_i        ( obi_write_rsp_i                 ),
+    .obi_req_o        ( ch_obi_write_req                ),
+    .obi_rsp_i        ( ch_obi_write_rsp                ),
     .transfer_busy_o  ( a2o_transfer_busy               ),
     .transfer_start_o ( a2o_transfer_start              ),
     .transfer_done_o  ( a2o_transfer_done               ),
@@ -126,6 +179,8 @@ module idma_ctrl_mm
   idma_axi_obi_transfer_ch #(
     .CHANNEL_T         ( magia_tile_pkg::OBI2AXI           ),
     .ERROR_CAP         ( ERROR_CAP                         ),
+    .MAX_OUTSTANDING   ( MAX_OUTSTANDING                   ),
+    .NUM_AX_IN_FLIGHT  ( NUM_AX_IN_FLIGHT                  ),
     .idma_fe_reg_req_t ( magia_tile_pkg::idma_fe_reg_req_t ),
     .idma_fe_reg_rsp_t ( magia_tile_pkg::idma_fe_reg_rsp_t ),
     .axi_req_t         ( magia_tile_pkg::idma_axi_req_t    ),
@@ -141,8 +196,8 @@ module idma_ctrl_mm
     .cfg_rsp_o        ( idma_fe_reg_obi2axi_rsp         ),
     .axi_req_o        ( axi_write_req_o                 ),
     .axi_rsp_i        ( axi_write_rsp_i                 ),
-    .obi_req_o        ( obi_read_req_o                  ),
-    .obi_rsp_i        ( obi_read_rsp_i                  ),
+    .obi_req_o        ( ch_obi_read_req                 ),
+    .obi_rsp_i        ( ch_obi_read_rsp                 ),
     .transfer_busy_o  ( o2a_transfer_busy               ),
     .transfer_start_o ( o2a_transfer_start              ),
     .transfer_done_o  ( o2a_transfer_done               ),
@@ -154,25 +209,174 @@ module idma_ctrl_mm
 /*******************************************************/
 
   idma_obi_ctrl_decoder i_idma_obi_ctrl_decoder (
-    .obi_req_i           ( obi_req_i               ),
-    .obi_rsp_o           ( obi_rsp_o               ),
+    .obi_req_i                ( obi_req_i         ),
+    .obi_rsp_o                ( obi_rsp_o         ),
+
+    .idma_axi2obi_req_o       ( core_axi2obi_req  ),
+    .idma_axi2obi_rsp_i       ( core_axi2obi_rsp  ),
+    .idma_obi2axi_req_o       ( core_obi2axi_req  ),
+    .idma_obi2axi_rsp_i       ( core_obi2axi_rsp  ),
+
+    .idma_axi2obi_chain_req_o ( chain_axi2obi_req ),
+    .idma_axi2obi_chain_rsp_i ( chain_axi2obi_rsp ),
+    .idma_obi2axi_chain_req_o ( chain_obi2axi_req ),
+    .idma_obi2axi_chain_rsp_i ( chain_obi2axi_rsp ),
+
+    .idma_axi2obi_coal_req_o  ( coal_axi2obi_req  ),
+    .idma_axi2obi_coal_rsp_i  ( coal_axi2obi_rsp  ),
+    .idma_obi2axi_coal_req_o  ( coal_obi2axi_req  ),
+    .idma_obi2axi_coal_rsp_i  ( coal_obi2axi_rsp  ),
+
+    .idma_axi2obi_xform_req_o ( xform_axi2obi_req ),
+    .idma_axi2obi_xform_rsp_i ( xform_axi2obi_rsp ),
+    .idma_obi2axi_xform_req_o ( xform_obi2axi_req ),
+    .idma_obi2axi_xform_rsp_i ( xform_obi2axi_rsp )
+  );
+
+/*******************************************************/
+/**               L1 Data Transform                   **/
+/*******************************************************/
+
+  idma_obi_xform #(
+    .CHANNEL_T         ( magia_tile_pkg::AXI2OBI ),
+    .MAX_OUTSTANDING   ( MAX_OUTSTANDING         ),
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t       ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t       ),
+    .obi_req_t         ( idma_obi_req_t          ),
+    .obi_rsp_t         ( idma_obi_rsp_t          )
+  ) i_l2_to_l1_xform (
+    .clk_i      ( clk_i             ),
+    .rst_ni     ( rst_ni            ),
+    .clear_i    ( clear_i           ),
+    .cfg_req_i  ( xform_axi2obi_req ),
+    .cfg_rsp_o  ( xform_axi2obi_rsp ),
+    .chan_req_i ( ch_obi_write_req  ),
+    .chan_rsp_o ( ch_obi_write_rsp  ),
+    .mem_req_o  ( obi_write_req_o   ),
+    .mem_rsp_i  ( obi_write_rsp_i   )
+  );
 
-    .idma_axi2obi_req_o  ( idma_fe_reg_axi2obi_req ),
-    .idma_axi2obi_rsp_i  ( idma_fe_reg_axi2obi_rsp ),
-    .idma_obi2axi_req_o  ( idma_fe_reg_obi2axi_req ),
-    .idma_obi2axi_rsp_i  ( idma_fe_reg_obi2axi_rsp )
+  idma_obi_xform #(
+    .CHANNEL_T         ( magia_tile_pkg::OBI2AXI ),
+    .MAX_OUTSTANDING   ( MAX_OUTSTANDING         ),
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t       ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t       ),
+    .obi_req_t         ( idma_obi_req_t          ),
+    .obi_rsp_t         ( idma_obi_rsp_t          )
+  ) i_l1_to_l2_xform (
+    .clk_i      ( clk_i             ),
+    .rst_ni     ( rst_ni            ),
+    .clear_i    ( clear_i           ),
+    .cfg_req_i  ( xform_obi2axi_req ),
+    .cfg_rsp_o  ( xform_obi2axi_rsp ),
+    .chan_req_i ( ch_obi_read_req   ),
+    .chan_rsp_o ( ch_obi_read_rsp   ),
+    .mem_req_o  ( obi_read_req_o    ),
+    .mem_rsp_i  ( obi_read_rsp_i    )
   );
 
+/*******************************************************/
+/**            Descriptor Chain Walkers               **/
+/*******************************************************/
+
+  idma_desc_chain #(
+    .obi_req_t         ( obi_req_t         ),
+    .obi_rsp_t         ( obi_rsp_t         ),
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t )
+  ) i_l2_to_l1_chain (
+    .clk_i          ( clk_i                ),
+    .rst_ni         ( rst_ni               ),
+    .clear_i        ( clear_i              ),
+    .chain_req_i    ( chain_axi2obi_req    ),
+    .chain_rsp_o    ( chain_axi2obi_rsp    ),
+    .desc_obi_req_o ( desc_a2o_obi_req_o   ),
+    .desc_obi_rsp_i ( desc_a2o_obi_rsp_i   ),
+    .fe_req_o       ( chain_axi2obi_fe_req ),
+    .fe_rsp_i       ( chain_axi2obi_fe_rsp ),
+    .busy_o         (                      ),
+    .chain_done_o   ( irq_a2o_chain_done_o )
+  );
+
+  idma_desc_chain #(
+    .obi_req_t         ( obi_req_t         ),
+    .obi_rsp_t         ( obi_rsp_t         ),
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t )
+  ) i_l1_to_l2_chain (
+    .clk_i          ( clk_i                ),
+    .rst_ni         ( rst_ni               ),
+    .clear_i        ( clear_i              ),
+    .chain_req_i    ( chain_obi2axi_req    ),
+    .chain_rsp_o    ( chain_obi2axi_rsp    ),
+    .desc_obi_req_o ( desc_o2a_obi_req_o   ),
+    .desc_obi_rsp_i ( desc_o2a_obi_rsp_i   ),
+    .fe_req_o       ( chain_obi2axi_fe_req ),
+    .fe_rsp_i       ( chain_obi2axi_fe_rsp ),
+    .busy_o         (                      ),
+    .chain_done_o   ( irq_o2a_chain_done_o )
+  );
+
+  // Register frontend arbitration: the core always wins, a walker is only served on
+  // the cycles in which the core does not access the registers of that channel
+  always_comb begin: fe_reg_arbiter
+    idma_fe_reg_axi2obi_req = core_axi2obi_req.valid ? core_axi2obi_req : chain_axi2obi_fe_req;
+    core_axi2obi_rsp        = idma_fe_reg_axi2obi_rsp;
+    chain_axi2obi_fe_rsp    = idma_fe_reg_axi2obi_rsp;
+    if (core_axi2obi_req.valid)
+      chain_axi2obi_fe_rsp.ready = 1'b0;
+    else
+      core_axi2obi_rsp.ready     = 1'b0;
+
+    idma_fe_reg_obi2axi_req = core_obi2axi_req.valid ? core_obi2axi_req : chain_obi2axi_fe_req;
+    core_obi2axi_rsp        = idma_fe_reg_obi2axi_rsp;
+    chain_obi2axi_fe_rsp    = idma_fe_reg_obi2axi_rsp;
+    if (core_obi2axi_req.valid)
+      chain_obi2axi_fe_rsp.ready = 1'b0;
+    else
+      core_obi2axi_rsp.ready     = 1'b0;
+  end
+
+
+/*******************************************************/
+/**            Completion Coalescing                  **/
+/*******************************************************/
+
+  idma_done_coalesce #(
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t )
+  ) i_l2_to_l1_coalesce (
+    .clk_i     ( clk_i              ),
+    .rst_ni    ( rst_ni             ),
+    .clear_i   ( clear_i            ),
+    .cfg_req_i ( coal_axi2obi_req   ),
+    .cfg_rsp_o ( coal_axi2obi_rsp   ),
+    .done_i    ( a2o_transfer_done  ),
+    .busy_i    ( a2o_transfer_busy  ),
+    .done_o    ( irq_a2o_done_o     )
+  );
+
+  idma_done_coalesce #(
+    .idma_fe_reg_req_t ( idma_fe_reg_req_t ),
+    .idma_fe_reg_rsp_t ( idma_fe_reg_rsp_t )
+  ) i_l1_to_l2_coalesce (
+    .clk_i     ( clk_i              ),
+    .rst_ni    ( rst_ni             ),
+    .clear_i   ( clear_i            ),
+    .cfg_req_i ( coal_obi2axi_req   ),
+    .cfg_rsp_o ( coal_obi2axi_rsp   ),
+    .done_i    ( o2a_transfer_done  ),
+    .busy_i    ( o2a_transfer_busy  ),
+    .done_o    ( irq_o2a_done_o     )
+  );
 
-  // Clean IRQ pass-through logic - equivalent to idma_ctrl behavior
+  // Clean IRQ pass-through logic - equivalent to idma_ctrl behavior (done is coalesced above)
   assign irq_a2o_start_o = a2o_transfer_start;
   assign irq_a2o_busy_o  = a2o_transfer_busy;
-  assign irq_a2o_done_o  = a2o_transfer_done;
   assign irq_a2o_error_o = a2o_transfer_error;
   
   assign irq_o2a_start_o = o2a_transfer_start;
   assign irq_o2a_busy_o  = o2a_transfer_busy;
-  assign irq_o2a_done_o  = o2a_transfer_done;
   assign irq_o2a_error_o = o2a_transfer_error;
 
 /*******************************************************/
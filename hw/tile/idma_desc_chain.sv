@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * iDMA Descriptor Chain Walker
+ *
+ * Walks a linked list of transfer descriptors in L1 and programs each of them
+ * on the register frontend of one iDMA transfer channel, as the core would.
+ * The core only writes the address of the first descriptor to CHAIN_HEAD.
+ *
+ * Descriptor layout (32-bit words, word-aligned in L1):
+ *   0: NEXT   - address of the next descriptor, 0 ends the chain
+ *   1: CTRL   - [11:0] IDMA_CONF value, [30] gather, [31] raise chain_done_o once this job retires
+ *   2: DST    3: SRC    4: LENGTH
+ *   5: DST_STRIDE_2    6: SRC_STRIDE_2    7: REPS_2
+ *   8: DST_STRIDE_3    9: SRC_STRIDE_3   10: REPS_3
+ *
+ * A gather descriptor (CTRL[30]) copies REPS_2 rows of LENGTH bytes to DST, packed
+ * one after the other. Row i starts at SRC + IDX[i], IDX being the list of 32-bit
+ * byte offsets at the L1 address DST_STRIDE_2. The walker fetches one offset per row
+ * and launches one 1D job per row, reprogramming only DST and SRC after the first.
+ *
+ * chain_done_o pulses once the last job of the chain has retired, and also after
+ * every descriptor with CTRL[31] set (the walker waits for it before going on).
+ */
+
+module idma_desc_chain
+  import magia_tile_pkg::*;
+#(
+  parameter type obi_req_t         = magia_tile_pkg::core_obi_data_req_t,
+  parameter type obi_rsp_t         = magia_tile_pkg::core_obi_data_rsp_t,
+  parameter type idma_fe_reg_req_t = magia_tile_pkg::idma_fe_reg_req_t,
+  parameter type idma_fe_reg_rsp_t = magia_tile_pkg::idma_fe_reg_rsp_t
+)(
+  input  logic             clk_i,
+  input  logic             rst_ni,
+  input  logic             clear_i,
+
+  // Chain registers (CHAIN_* offsets, from the OBI decoder)
+  input  idma_fe_reg_req_t chain_req_i,
+  output idma_fe_reg_rsp_t chain_rsp_o,
+
+  // Descriptor fetch (to L1 through the OBI XBAR)
+  output obi_req_t         desc_obi_req_o,
+  input  obi_rsp_t         desc_obi_rsp_i,
+
+  // Job programming (to the register frontend of the transfer channel)
+  output idma_fe_reg_req_t fe_req_o,
+  input  idma_fe_reg_rsp_t fe_rsp_i,
+
+  output logic             busy_o,
+  output logic             chain_done_o
+);
+
+/*******************************************************/
+/**       Internal Signal Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned DESC_WORDS = 11;
+  localparam int unsigned PROG_REGS  = 10;
+
+  localparam logic [11:0] CHAIN_HEAD_OFFSET    = magia_tile_pkg::IDMA_CHAIN_HEAD_OFFSET;
+  localparam logic [11:0] CHAIN_STATUS_OFFSET  = magia_tile_pkg::IDMA_CHAIN_STATUS_OFFSET;
+  localparam logic [11:0] CHAIN_LAST_ID_OFFSET = magia_tile_pkg::IDMA_CHAIN_LAST_ID_OFFSET;
+
+  localparam logic [11:0] NEXT_ID_0_OFFSET = 12'h44;
+  localparam logic [11:0] DONE_ID_0_OFFSET = 12'h84;
+
+  // Register frontend offsets programmed from descriptor words 1 to 10
+  localparam logic [PROG_REGS-1:0][11:0] PROG_OFFSET = {
+    12'h110, 12'h108, 12'h100,  // REPS_3, SRC_STRIDE_3, DST_STRIDE_3
+    12'h0f8, 12'h0f0, 12'h0e8,  // REPS_2, SRC_STRIDE_2, DST_STRIDE_2
+    12'h0e0, 12'h0d8, 12'h0d0,  // LENGTH, SRC_ADDR, DST_ADDR
+    12'h000                     // CONF
+  };
+
+  typedef enum logic [2:0] {
+    IDLE,
+    FETCH_REQ,
+    FETCH_RSP,
+    INDEX_REQ,
+    INDEX_RSP,
+    PROG,
+    LAUNCH,
+    FENCE
+  } chain_state_e;
+
+  chain_state_e state_q, state_d;
+
+  logic [DESC_WORDS-1:0][31:0] desc_q,    desc_d;
+  logic [31:0]                 cur_q,     cur_d;      // Address of the current descriptor
+  logic [3:0]                  idx_q,     idx_d;      // Word being fetched or register being programmed
+  logic [31:0]                 last_id_q, last_id_d;  // ID of the last job launched
+  logic                        final_q,   final_d;    // The fence closes the chain
+
+  // Gather descriptors
+  logic        gather;
+  logic [31:0] row_q,     row_d;      // Row being moved
+  logic [31:0] row_dst_q, row_dst_d;  // Its destination
+  logic [31:0] row_off_q, row_off_d;  // Its offset from SRC
+  logic [31:0] prog_wdata;
+
+  logic [11:0] chain_offset;
+  logic        head_write;
+
+/*******************************************************/
+/**          Internal Signal Definitions End          **/
+/*******************************************************/
+/**              Chain Registers Beginning            **/
+/*******************************************************/
+
+  assign chain_offset = chain_req_i.addr[11:0];
+  assign head_write   = chain_req_i.valid && chain_req_i.write && (chain_offset == CHAIN_HEAD_OFFSET);
+
+  always_comb begin: chain_regs
+    chain_rsp_o       = '0;
+    chain_rsp_o.ready = chain_req_i.valid;
+    case (chain_offset)
+      CHAIN_HEAD_OFFSET:    chain_rsp_o.rdata = cur_q;
+      CHAIN_STATUS_OFFSET:  chain_rsp_o.rdata = {31'b0, busy_o};
+      CHAIN_LAST_ID_OFFSET: chain_rsp_o.rdata = last_id_q;
+      default:              chain_rsp_o.error = chain_req_i.valid;
+    endcase
+    // A new chain is only accepted once the previous one is over
+    if (head_write && busy_o)
+      chain_rsp_o.error = 1'b1;
+  end
+
+  assign busy_o = (state_q != IDLE);
+
+/*******************************************************/
+/**                Chain Registers End                **/
+/*******************************************************/
+/**               Job Programming Beginning           **/
+/*******************************************************/
+
+  assign gather = desc_q[1][30];
+
+  // A gather row is a 1D job: strides 0, repetitions 1
+  always_comb begin: prog_data
+    if (idx_q == 0)
+      prog_wdata = {20'h0, desc_q[1][11:0]};
+    else if (!gather)
+      prog_wdata = desc_q[idx_q+1];
+    else begin
+      case (idx_q)
+        4'd1:       prog_wdata = row_dst_q;
+        4'd2:       prog_wdata = desc_q[3] + row_off_q;
+        4'd3:       prog_wdata = desc_q[4];
+        4'd6, 4'd9: prog_wdata = 32'd1;
+        default:    prog_wdata = '0;
+      endcase
+    end
+  end
+
+/*******************************************************/
+/**                Job Programming End                **/
+/*******************************************************/
+/**                 Chain Walk Beginning              **/
+/*******************************************************/
+
+  always_comb begin: chain_fsm
+    state_d      = state_q;
+    desc_d       = desc_q;
+    cur_d        = cur_q;
+    idx_d        = idx_q;
+    last_id_d    = last_id_q;
+    final_d      = final_q;
+    row_d        = row_q;
+    row_dst_d    = row_dst_q;
+    row_off_d    = row_off_q;
+    chain_done_o = 1'b0;
+
+    desc_obi_req_o        = '0;
+    desc_obi_req_o.a.addr = cur_q + {idx_q, 2'b00};
+    desc_obi_req_o.a.be   = '1;
+
+    fe_req_o       = '0;
+    fe_req_o.wstrb = '1;
+
+    case (state_q)
+      IDLE: begin
+        if (head_write && (chain_req_i.wdata != '0)) begin
+          cur_d   = chain_req_i.wdata;
+          idx_d   = '0;
+          final_d = 1'b0;
+          state_d = FETCH_REQ;
+        end
+      end
+
+      FETCH_REQ: begin
+        desc_obi_req_o.req = 1'b1;
+        if (desc_obi_rsp_i.gnt)
+          state_d = FETCH_RSP;
+      end
+
+      FETCH_RSP: begin
+        if (desc_obi_rsp_i.rvalid) begin
+          desc_d[idx_q] = desc_obi_rsp_i.r.rdata;
+          if (idx_q == DESC_WORDS-1) begin
+            idx_d     = '0;
+            row_d     = '0;
+            row_dst_d = desc_q[2];
+            if (!desc_q[1][30]) begin
+              state_d = PROG;
+            end else if (desc_q[7] != '0) begin
+              state_d = INDEX_REQ;
+            end else if (desc_q[1][31] || (desc_q[0] == '0)) begin
+              // An empty gather launches nothing, its fence waits for the previous jobs
+              final_d = (desc_q[0] == '0);
+              state_d = FENCE;
+            end else begin
+              cur_d   = desc_q[0];
+              state_d = FETCH_REQ;
+            end
+          end else begin
+            idx_d   = idx_q + 1;
+            state_d = FETCH_REQ;
+          end
+        end
+      end
+
+      INDEX_REQ: begin
+        desc_obi_req_o.req    = 1'b1;
+        desc_obi_req_o.a.addr = desc_q[5] + {row_q[29:0], 2'b00};
+        if (desc_obi_rsp_i.gnt)
+          state_d = INDEX_RSP;
+      end
+
+      // The job registers keep their values: after the first row only DST and SRC change
+      INDEX_RSP: begin
+        if (desc_obi_rsp_i.rvalid) begin
+          row_off_d = desc_obi_rsp_i.r.rdata;
+          idx_d     = (row_q == '0) ? 4'd0 : 4'd1;
+          state_d   = PROG;
+        end
+      end
+
+      PROG: begin
+        fe_req_o.valid = 1'b1;
+        fe_req_o.write = 1'b1;
+        fe_req_o.addr  = {20'h0, PROG_OFFSET[idx_q]};
+        fe_req_o.wdata = prog_wdata;
+        if (fe_rsp_i.ready) begin
+          if ((idx_q == PROG_REGS-1) || (gather && (row_q != '0) && (idx_q == 4'd2))) begin
+            idx_d   = '0;
+            state_d = LAUNCH;
+          end else begin
+            idx_d   = idx_q + 1;
+          end
+        end
+      end
+
+      // Reading NEXT_ID issues the job, as for the core
+      LAUNCH: begin
+        fe_req_o.valid = 1'b1;
+        fe_req_o.addr  = {20'h0, NEXT_ID_0_OFFSET};
+        if (fe_rsp_i.ready) begin
+          last_id_d = fe_rsp_i.rdata;
+          final_d   = (desc_q[0] == '0);
+          if (gather && (row_q + 1 < desc_q[7])) begin
+            row_d     = row_q + 1;
+            row_dst_d = row_dst_q + desc_q[4];
+            state_d   = INDEX_REQ;
+          end else if (desc_q[1][31] || (desc_q[0] == '0)) begin
+            state_d = FENCE;
+          end else begin
+            cur_d   = desc_q[0];
+            state_d = FETCH_REQ;
+          end
+        end
+      end
+
+      // Local DONE_ID polling, no traffic on the interconnect
+      FENCE: begin
+        fe_req_o.valid = 1'b1;
+        fe_req_o.addr  = {20'h0, DONE_ID_0_OFFSET};
+        if (fe_rsp_i.ready && ($signed(fe_rsp_i.rdata - last_id_q) >= 0)) begin
+          chain_done_o = 1'b1;
+          if (final_q) begin
+            state_d = IDLE;
+          end else begin
+            cur_d   = desc_q[0];
+            state_d = FETCH_REQ;
+          end
+        end
+      end
+
+      default: state_d = IDLE;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: chain_regs_ff
+    if (!rst_ni) begin
+      state_q   <= IDLE;
+      desc_q    <= '0;
+      cur_q     <= '0;
+      idx_q     <= '0;
+      last_id_q <= '0;
+      final_q   <= 1'b0;
+      row_q     <= '0;
+      row_dst_q <= '0;
+      row_off_q <= '0;
+    end else if (clear_i) begin
+      state_q   <= IDLE;
+      idx_q     <= '0;
+      final_q   <= 1'b0;
+    end else begin
+      state_q   <= state_d;
+      desc_q    <= desc_d;
+      cur_q     <= cur_d;
+      idx_q     <= idx_d;
+      last_id_q <= last_id_d;
+      final_q   <= final_d;
+      row_q     <= row_d;
+      row_dst_q <= row_dst_d;
+      row_off_q <= row_off_d;
+    end
+  end
+
+/*******************************************************/
+/**                  Chain Walk End                   **/
+/*******************************************************/
+
+endmodule: idma_desc_chain
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * iDMA Completion Coalescing
+ *
+ * Merges the done pulses of one iDMA transfer channel into fewer events: done_o
+ * pulses once COUNT jobs have retired, once TIMEOUT cycles have passed since the
+ * first pending completion, or once the channel goes idle with completions pending,
+ * whichever comes first. The idle flush guarantees that the last job of a stream
+ * is always signalled. With COUNT 0 or 1 (reset value) done_i is passed through.
+ */
+
+module idma_done_coalesce
+  import magia_tile_pkg::*;
+#(
+  parameter type idma_fe_reg_req_t = magia_tile_pkg::idma_fe_reg_req_t,
+  parameter type idma_fe_reg_rsp_t = magia_tile_pkg::idma_fe_reg_rsp_t
+)(
+  input  logic             clk_i,
+  input  logic             rst_ni,
+  input  logic             clear_i,
+
+  // Coalescing registers (COALESCE_* offsets, from the OBI decoder)
+  input  idma_fe_reg_req_t cfg_req_i,
+  output idma_fe_reg_rsp_t cfg_rsp_o,
+
+  input  logic             done_i,   // One pulse per retired job
+  input  logic             busy_i,   // Channel busy
+  output logic             done_o
+);
+
+/*******************************************************/
+/**       Internal Signal Definitions Beginning       **/
+/*******************************************************/
+
+  localparam logic [11:0] COUNT_OFFSET   = magia_tile_pkg::IDMA_COALESCE_COUNT_OFFSET;
+  localparam logic [11:0] TIMEOUT_OFFSET = magia_tile_pkg::IDMA_COALESCE_TIMEOUT_OFFSET;
+
+  logic [31:0] count_q;     // Completions per event
+  logic [31:0] timeout_q;   // Cycles from the first pending completion to the event
+  logic [31:0] pending_q,   pending_d;
+  logic [31:0] timer_q,     timer_d;
+
+  logic [11:0] cfg_offset;
+  logic        bypass;
+  logic        flush;
+
+/*******************************************************/
+/**          Internal Signal Definitions End          **/
+/*******************************************************/
+/**           Coalescing Registers Beginning          **/
+/*******************************************************/
+
+  assign cfg_offset = cfg_req_i.addr[11:0];
+
+  always_comb begin: coal_regs
+    cfg_rsp_o       = '0;
+    cfg_rsp_o.ready = cfg_req_i.valid;
+    case (cfg_offset)
+      COUNT_OFFSET:   cfg_rsp_o.rdata = count_q;
+      TIMEOUT_OFFSET: cfg_rsp_o.rdata = timeout_q;
+      default:        cfg_rsp_o.error = cfg_req_i.valid;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: coal_regs_ff
+    if (!rst_ni) begin
+      count_q   <= '0;
+      timeout_q <= '0;
+    end else if (cfg_req_i.valid && cfg_req_i.write) begin
+      if (cfg_offset == COUNT_OFFSET)   count_q   <= cfg_req_i.wdata;
+      if (cfg_offset == TIMEOUT_OFFSET) timeout_q <= cfg_req_i.wdata;
+    end
+  end
+
+/*******************************************************/
+/**             Coalescing Registers End              **/
+/*******************************************************/
+/**                Coalescing Beginning               **/
+/*******************************************************/
+
+  assign bypass = (count_q <= 32'd1);
+
+  always_comb begin: coal_logic
+    pending_d = pending_q + {31'b0, done_i};
+    timer_d   = (pending_q != '0) ? timer_q + 1 : '0;
+
+    flush = (pending_d >= count_q) ||
+            ((timeout_q != '0) && (pending_q != '0) && (timer_q >= timeout_q)) ||
+            (!busy_i && (pending_d != '0));
+    flush = flush && (pending_d != '0);
+
+    if (bypass || flush) begin
+      pending_d = '0;
+      timer_d   = '0;
+    end
+  end
+
+  assign done_o = bypass ? done_i : flush;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: coal_ff
+    if (!rst_ni) begin
+      pending_q <= '0;
+      timer_q   <= '0;
+    end else if (clear_i) begin
+      pending_q <= '0;
+      timer_q   <= '0;
+    end else begin
+      pending_q <= pending_d;
+      timer_q   <= timer_d;
+    end
+  end
+
+/*******************************************************/
+/**                  Coalescing End                   **/
+/*******************************************************/
+
+endmodule: idma_done_coalesce
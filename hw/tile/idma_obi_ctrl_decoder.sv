@@ -39,7 +39,28 @@ module idma_obi_ctrl_decoder
   input  idma_fe_reg_rsp_t idma_axi2obi_rsp_i,
   
   output idma_fe_reg_req_t idma_obi2axi_req_o, 
-  input  idma_fe_reg_rsp_t idma_obi2axi_rsp_i
+  input  idma_fe_reg_rsp_t idma_obi2axi_rsp_i,
+
+  // Descriptor Chain Register Interface
+  output idma_fe_reg_req_t idma_axi2obi_chain_req_o,
+  input  idma_fe_reg_rsp_t idma_axi2obi_chain_rsp_i,
+
+  output idma_fe_reg_req_t idma_obi2axi_chain_req_o,
+  input  idma_fe_reg_rsp_t idma_obi2axi_chain_rsp_i,
+
+  // Completion Coalescing Register Interface
+  output idma_fe_reg_req_t idma_axi2obi_coal_req_o,
+  input  idma_fe_reg_rsp_t idma_axi2obi_coal_rsp_i,
+
+  output idma_fe_reg_req_t idma_obi2axi_coal_req_o,
+  input  idma_fe_reg_rsp_t idma_obi2axi_coal_rsp_i,
+
+  // L1 Data Transform Register Interface
+  output idma_fe_reg_req_t idma_axi2obi_xform_req_o,
+  input  idma_fe_reg_rsp_t idma_axi2obi_xform_rsp_i,
+
+  output idma_fe_reg_req_t idma_obi2axi_xform_req_o,
+  input  idma_fe_reg_rsp_t idma_obi2axi_xform_rsp_i
 );
 
 /*******************************************************/
@@ -77,9 +98,25 @@ module idma_obi_ctrl_decoder
   localparam logic [11:0] IDMA_SRC_STRIDE_3_LOW_OFFSET = 12'h108;
   localparam logic [11:0] IDMA_REPS_3_LOW_OFFSET = 12'h110;
 
+  // Descriptor chain registers, served by idma_desc_chain
+  localparam logic [11:0] IDMA_CHAIN_HEAD_OFFSET    = magia_tile_pkg::IDMA_CHAIN_HEAD_OFFSET;
+  localparam logic [11:0] IDMA_CHAIN_STATUS_OFFSET  = magia_tile_pkg::IDMA_CHAIN_STATUS_OFFSET;
+  localparam logic [11:0] IDMA_CHAIN_LAST_ID_OFFSET = magia_tile_pkg::IDMA_CHAIN_LAST_ID_OFFSET;
+
+  // Completion coalescing registers, served by idma_done_coalesce
+  localparam logic [11:0] IDMA_COALESCE_COUNT_OFFSET   = magia_tile_pkg::IDMA_COALESCE_COUNT_OFFSET;
+  localparam logic [11:0] IDMA_COALESCE_TIMEOUT_OFFSET = magia_tile_pkg::IDMA_COALESCE_TIMEOUT_OFFSET;
+
+  // L1 data transform registers, served by idma_obi_xform
+  localparam logic [11:0] IDMA_XFORM_MODE_OFFSET = magia_tile_pkg::IDMA_XFORM_MODE_OFFSET;
+  localparam logic [11:0] IDMA_XFORM_ARG_OFFSET  = magia_tile_pkg::IDMA_XFORM_ARG_OFFSET;
+
   logic direction; // Direction of the iDMA channel: 0 -> AXI2OBI; 1 -> OBI2AXI  
   logic [11:0] reg_offset;
   logic is_valid_access;
+  logic is_chain_access;
+  logic is_coal_access;
+  logic is_xform_access;
   logic is_address_in_range;
   
   idma_fe_reg_req_t selected_idma_req;
@@ -119,7 +156,26 @@ module idma_obi_ctrl_decoder
                           (reg_offset == IDMA_REPS_2_LOW_OFFSET) ||
                           (reg_offset == IDMA_DST_STRIDE_3_LOW_OFFSET) ||
                           (reg_offset == IDMA_SRC_STRIDE_3_LOW_OFFSET) ||
-                          (reg_offset == IDMA_REPS_3_LOW_OFFSET)
+                          (reg_offset == IDMA_REPS_3_LOW_OFFSET) ||
+                          is_chain_access ||
+                          is_coal_access ||
+                          is_xform_access
+                          );
+
+  assign is_chain_access = is_address_in_range && (
+                          (reg_offset == IDMA_CHAIN_HEAD_OFFSET) ||
+                          (reg_offset == IDMA_CHAIN_STATUS_OFFSET) ||
+                          (reg_offset == IDMA_CHAIN_LAST_ID_OFFSET)
+                          );
+
+  assign is_coal_access = is_address_in_range && (
+                          (reg_offset == IDMA_COALESCE_COUNT_OFFSET) ||
+                          (reg_offset == IDMA_COALESCE_TIMEOUT_OFFSET)
+                          );
+
+  assign is_xform_access = is_address_in_range && (
+                          (reg_offset == IDMA_XFORM_MODE_OFFSET) ||
+                          (reg_offset == IDMA_XFORM_ARG_OFFSET)
                           );
 
 /*******************************************************/
@@ -133,15 +189,43 @@ module idma_obi_ctrl_decoder
     // Default assignments
     idma_axi2obi_req_o = '0;
     idma_obi2axi_req_o = '0;
+    idma_axi2obi_chain_req_o = '0;
+    idma_obi2axi_chain_req_o = '0;
+    idma_axi2obi_coal_req_o = '0;
+    idma_obi2axi_coal_req_o = '0;
+    idma_axi2obi_xform_req_o = '0;
+    idma_obi2axi_xform_req_o = '0;
     selected_idma_rsp = '0;
     
     if (is_valid_access && obi_req_i.req) begin
       if (direction) begin  // OBI2AXI channel (L1->L2)
-        idma_obi2axi_req_o = selected_idma_req;
-        selected_idma_rsp = idma_obi2axi_rsp_i;
+        if (is_chain_access) begin
+          idma_obi2axi_chain_req_o = selected_idma_req;
+          selected_idma_rsp = idma_obi2axi_chain_rsp_i;
+        end else if (is_coal_access) begin
+          idma_obi2axi_coal_req_o = selected_idma_req;
+          selected_idma_rsp = idma_obi2axi_coal_rsp_i;
+        end else if (is_xform_access) begin
+          idma_obi2axi_xform_req_o = selected_idma_req;
+          selected_idma_rsp = idma_obi2axi_xform_rsp_i;
+        end else begin
+          idma_obi2axi_req_o = selected_idma_req;
+          selected_idma_rsp = idma_obi2axi_rsp_i;
+        end
       end else begin        // AXI2OBI channel (L2->L1)
-        idma_axi2obi_req_o = selected_idma_req;
-        selected_idma_rsp = idma_axi2obi_rsp_i;
+        if (is_chain_access) begin
+          idma_axi2obi_chain_req_o = selected_idma_req;
+          selected_idma_rsp = idma_axi2obi_chain_rsp_i;
+        end else if (is_coal_access) begin
+          idma_axi2obi_coal_req_o = selected_idma_req;
+          selected_idma_rsp = idma_axi2obi_coal_rsp_i;
+        end else if (is_xform_access) begin
+          idma_axi2obi_xform_req_o = selected_idma_req;
+          selected_idma_rsp = idma_axi2obi_xform_rsp_i;
+        end else begin
+          idma_axi2obi_req_o = selected_idma_req;
+          selected_idma_rsp = idma_axi2obi_rsp_i;
+        end
       end
     end
   end
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * iDMA L1 Data Transform
+ *
+ * Sits on the L1 (OBI) port of one iDMA transfer channel and transforms the data
+ * of the jobs while they move. The mode and its argument are set through the
+ * XFORM_MODE / XFORM_ARG registers and must only change while the channel is idle.
+ *
+ * AXI2OBI (L1 write side):
+ *   FILL       - every byte written is taken from the ARG pattern (memset)
+ *   FP32_FP16  - each 32-bit beat is an FP32, written as FP16 at ARG + (addr - ARG)/2
+ *   FP32_FP8   - each 32-bit beat is an FP32, written as FP8 (E5M2) at ARG + (addr - ARG)/4
+ * OBI2AXI (L1 read side):
+ *   FILL       - every beat read returns the ARG pattern
+ *   FP16_FP32  - the beat at addr returns the FP16 at ARG + (addr - ARG)/2 as FP32
+ *   FP8_FP32   - the beat at addr returns the FP8 (E5M2) at ARG + (addr - ARG)/4 as FP32
+ * ARG is the L1 address of the packed buffer, the job sees the FP32 layout: its L1
+ * address is ARG and its length 4 bytes per element. Conversions round to nearest
+ * even, saturate to infinity and flush subnormals to zero.
+ */
+
+module idma_obi_xform
+  import magia_tile_pkg::*;
+#(
+  parameter magia_tile_pkg::idma_transfer_ch_e CHANNEL_T         = magia_tile_pkg::AXI2OBI,
+  parameter int unsigned                       MAX_OUTSTANDING   = magia_tile_pkg::iDMA_MaxOutstanding,
+  parameter type                               idma_fe_reg_req_t = magia_tile_pkg::idma_fe_reg_req_t,
+  parameter type                               idma_fe_reg_rsp_t = magia_tile_pkg::idma_fe_reg_rsp_t,
+  parameter type                               obi_req_t         = magia_tile_pkg::idma_obi_req_t,
+  parameter type                               obi_rsp_t         = magia_tile_pkg::idma_obi_rsp_t
+)(
+  input  logic             clk_i,
+  input  logic             rst_ni,
+  input  logic             clear_i,
+
+  // Transform registers (XFORM_* offsets, from the OBI decoder)
+  input  idma_fe_reg_req_t cfg_req_i,
+  output idma_fe_reg_rsp_t cfg_rsp_o,
+
+  // From the transfer channel
+  input  obi_req_t         chan_req_i,
+  output obi_rsp_t         chan_rsp_o,
+
+  // To L1
+  output obi_req_t         mem_req_o,
+  input  obi_rsp_t         mem_rsp_i
+);
+
+/*******************************************************/
+/**       Internal Signal Definitions Beginning       **/
+/*******************************************************/
+
+  localparam logic [11:0] MODE_OFFSET = magia_tile_pkg::IDMA_XFORM_MODE_OFFSET;
+  localparam logic [11:0] ARG_OFFSET  = magia_tile_pkg::IDMA_XFORM_ARG_OFFSET;
+
+  localparam logic [2:0] XFORM_NONE      = 3'd0;
+  localparam logic [2:0] XFORM_FILL      = 3'd1;
+  localparam logic [2:0] XFORM_FP32_FP16 = 3'd2;
+  localparam logic [2:0] XFORM_FP32_FP8  = 3'd3;
+  localparam logic [2:0] XFORM_FP16_FP32 = 3'd4;
+  localparam logic [2:0] XFORM_FP8_FP32  = 3'd5;
+
+  logic [2:0]  mode_q;
+  logic [31:0] arg_q;
+
+  logic [11:0] cfg_offset;
+
+  logic [31:0] rel_addr;     // Offset of the beat from ARG, FP32 layout
+  logic [31:0] packed_addr;  // Address of the element in the packed buffer
+
+  // Lane of each outstanding read in the packed buffer (read side)
+  logic       lane_push, lane_pop, lane_full;
+  logic [1:0] lane_in,   lane_out;
+
+/*******************************************************/
+/**          Internal Signal Definitions End          **/
+/*******************************************************/
+/**            Conversion Functions Beginning         **/
+/*******************************************************/
+
+  function automatic logic [15:0] fp32_to_fp16(logic [31:0] f);
+    logic [9:0]  mant;
+    logic        rnd, sticky;
+    logic [15:0] res;
+    int          exp;
+    exp = int'(f[30:23]) - 127 + 15;
+    if (f[30:23] == 8'hff)
+      return {f[31], 5'h1f, (f[22:0] != '0) ? 10'h200 : 10'h000};
+    if (exp >= 31)
+      return {f[31], 5'h1f, 10'h000};
+    if (exp <= 0)
+      return {f[31], 15'h0000};
+    mant   = f[22:13];
+    rnd    = f[12];
+    sticky = |f[11:0];
+    res    = {1'b0, exp[4:0], mant};
+    if (rnd && (sticky || mant[0]))
+      res = res + 1;  // A carry into the exponent rounds up to the next binade or to infinity
+    return {f[31], res[14:0]};
+  endfunction
+
+  function automatic logic [7:0] fp32_to_fp8(logic [31:0] f);
+    logic [1:0] mant;
+    logic       rnd, sticky;
+    logic [7:0] res;
+    int         exp;
+    exp = int'(f[30:23]) - 127 + 15;
+    if (f[30:23] == 8'hff)
+      return {f[31], 5'h1f, (f[22:0] != '0) ? 2'b10 : 2'b00};
+    if (exp >= 31)
+      return {f[31], 5'h1f, 2'b00};
+    if (exp <= 0)
+      return {f[31], 7'h00};
+    mant   = f[22:21];
+    rnd    = f[20];
+    sticky = |f[19:0];
+    res    = {1'b0, exp[4:0], mant};
+    if (rnd && (sticky || mant[0]))
+      res = res + 1;
+    return {f[31], res[6:0]};
+  endfunction
+
+  function automatic logic [31:0] fp16_to_fp32(logic [15:0] h);
+    if (h[14:10] == 5'h1f)
+      return {h[15], 8'hff, h[9:0], 13'h0000};
+    if (h[14:10] == 5'h00)
+      return {h[15], 31'h0000_0000};
+    return {h[15], 8'(h[14:10]) + 8'd112, h[9:0], 13'h0000};
+  endfunction
+
+/*******************************************************/
+/**              Conversion Functions End             **/
+/*******************************************************/
+/**             Transform Registers Beginning         **/
+/*******************************************************/
+
+  assign cfg_offset = cfg_req_i.addr[11:0];
+
+  always_comb begin: xform_regs
+    cfg_rsp_o       = '0;
+    cfg_rsp_o.ready = cfg_req_i.valid;
+    case (cfg_offset)
+      MODE_OFFSET: cfg_rsp_o.rdata = {29'b0, mode_q};
+      ARG_OFFSET:  cfg_rsp_o.rdata = arg_q;
+      default:     cfg_rsp_o.error = cfg_req_i.valid;
+    endcase
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: xform_regs_ff
+    if (!rst_ni) begin
+      mode_q <= XFORM_NONE;
+      arg_q  <= '0;
+    end else if (clear_i) begin
+      mode_q <= XFORM_NONE;
+    end else if (cfg_req_i.valid && cfg_req_i.write) begin
+      if (cfg_offset == MODE_OFFSET) mode_q <= cfg_req_i.wdata[2:0];
+      if (cfg_offset == ARG_OFFSET)  arg_q  <= cfg_req_i.wdata;
+    end
+  end
+
+/*******************************************************/
+/**               Transform Registers End             **/
+/*******************************************************/
+/**                 Data Path Beginning               **/
+/*******************************************************/
+
+  assign rel_addr = chan_req_i.a.addr - arg_q;
+
+  always_comb begin: packed_address
+    case (mode_q)
+      XFORM_FP32_FP16, XFORM_FP16_FP32: packed_addr = arg_q + {1'b0,  rel_addr[31:1]};
+      XFORM_FP32_FP8,  XFORM_FP8_FP32:  packed_addr = arg_q + {2'b00, rel_addr[31:2]};
+      default:                          packed_addr = chan_req_i.a.addr;
+    endcase
+  end
+
+  generate if (CHANNEL_T == magia_tile_pkg::AXI2OBI) begin: gen_write_side
+
+    always_comb begin: write_xform
+      mem_req_o  = chan_req_i;
+      chan_rsp_o = mem_rsp_i;
+      case (mode_q)
+        XFORM_FILL: begin
+          mem_req_o.a.wdata = arg_q;
+        end
+        XFORM_FP32_FP16: begin
+          mem_req_o.a.addr  = {packed_addr[31:2], 2'b00};
+          mem_req_o.a.wdata = {2{fp32_to_fp16(chan_req_i.a.wdata)}};
+          mem_req_o.a.be    = packed_addr[1] ? 4'b1100 : 4'b0011;
+        end
+        XFORM_FP32_FP8: begin
+          mem_req_o.a.addr  = {packed_addr[31:2], 2'b00};
+          mem_req_o.a.wdata = {4{fp32_to_fp8(chan_req_i.a.wdata)}};
+          mem_req_o.a.be    = 4'b0001 << packed_addr[1:0];
+        end
+        default: ;
+      endcase
+    end
+
+    assign lane_push = 1'b0;
+    assign lane_pop  = 1'b0;
+    assign lane_in   = '0;
+    assign lane_out  = '0;
+    assign lane_full = 1'b0;
+
+  end else begin: gen_read_side
+
+    assign lane_in   = packed_addr[1:0];
+    assign lane_push = mem_req_o.req && mem_rsp_i.gnt;
+    assign lane_pop  = mem_rsp_i.rvalid;
+
+    // OBI responses come back in order: the lane of each read follows it in a FIFO
+    fifo_v3 #(
+      .FALL_THROUGH ( 1'b0            ),
+      .DATA_WIDTH   ( 2               ),
+      .DEPTH        ( MAX_OUTSTANDING )
+    ) i_lane_fifo (
+      .clk_i      ( clk_i     ),
+      .rst_ni     ( rst_ni    ),
+      .flush_i    ( clear_i   ),
+      .testmode_i ( 1'b0      ),
+      .full_o     ( lane_full ),
+      .empty_o    (           ),
+      .usage_o    (           ),
+      .data_i     ( lane_in   ),
+      .push_i     ( lane_push ),
+      .data_o     ( lane_out  ),
+      .pop_i      ( lane_pop  )
+    );
+
+    always_comb begin: read_xform
+      mem_req_o      = chan_req_i;
+      mem_req_o.req  = chan_req_i.req && !lane_full;
+      chan_rsp_o     = mem_rsp_i;
+      chan_rsp_o.gnt = mem_rsp_i.gnt && !lane_full;
+      case (mode_q)
+        XFORM_FILL: begin
+          chan_rsp_o.r.rdata = arg_q;
+        end
+        XFORM_FP16_FP32: begin
+          mem_req_o.a.addr   = {packed_addr[31:2], 2'b00};
+          chan_rsp_o.r.rdata = fp16_to_fp32(lane_out[1] ? mem_rsp_i.r.rdata[31:16] : mem_rsp_i.r.rdata[15:0]);
+        end
+        XFORM_FP8_FP32: begin
+          mem_req_o.a.addr   = {packed_addr[31:2], 2'b00};
+          chan_rsp_o.r.rdata = fp16_to_fp32({mem_rsp_i.r.rdata[8*lane_out +: 8], 8'h00});
+        end
+        default: ;
+      endcase
+    end
+
+  end endgenerate
+
+/*******************************************************/
+/**                   Data Path End                   **/
+/*******************************************************/
+
+endmodule: idma_obi_xform
@@ -16,17 +16,17 @@
  *
  * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
  *          
- * Wrapper module for MAGIA Event Unit optimized for single-core systems
+ * Wrapper module for MAGIA Event Unit, sized for the NB_CORES cores of the Tile
 */
 
 module magia_event_unit
 import magia_tile_pkg::*;
 import magia_pkg::*;
 #(
-  // MAGIA Event Unit Parameters - Optimized for single-core system
-  parameter int unsigned NB_CORES = 1,              // Single core system
+  // MAGIA Event Unit Parameters - Defaults match the single-core Tile
+  parameter int unsigned NB_CORES = 1,              // Number of cores served by the Event Unit
   parameter int unsigned NB_SW_EVT = 1,             // Minimal SW events for basic functionality
-  parameter int unsigned NB_BARR  = 0,              // Barrier units disabled (no sync needed)
+  parameter int unsigned NB_BARR  = 0,              // Barrier units (only needed with NB_CORES > 1)
   parameter int unsigned NB_HW_MUT = 0,             // Hardware mutexes disabled (no contention)
   parameter int unsigned MUTEX_MSG_W = 32,          // Mutex message width (unused but kept for compatibility)
   parameter int unsigned DISP_FIFO_DEPTH = 0,       // Task dispatcher disabled (no distribution)
@@ -65,6 +65,8 @@ import magia_pkg::*;
 );
 
   // Create internal interface instance - only speriph_slave
+  // All the cores share the peripheral port: core i reaches its private register
+  // bank at offset i*0x40, while barriers and SW events live in the shared area
   XBAR_PERIPH_BUS #(.ID_WIDTH(NB_CORES+1)) speriph_slave();
 
   // Create dummy eu_direct_link interfaces (tied off, not used)
@@ -124,6 +124,7 @@ module magia_tile
   logic[magia_pkg::ADDR_W-1:0] tile_l1_end_addr;
   logic[magia_pkg::ADDR_W-1:0] tile_reserved_start_addr;
   logic[magia_pkg::ADDR_W-1:0] tile_reserved_end_addr;
+  logic[magia_pkg::ADDR_W-1:0] tile_l1_notify_addr;
   logic[magia_pkg::ADDR_W-1:0] tile_redmule_ctrl_start_addr;
   logic[magia_pkg::ADDR_W-1:0] tile_redmule_ctrl_end_addr;
   logic[magia_pkg::ADDR_W-1:0] tile_idma_ctrl_start_addr;
@@ -141,11 +142,11 @@ module magia_tile
 
   // OBI to iDMA Bridge (Memory-mapped interface) - now encapsulated in idma_ctrl_mm
 
-  magia_tile_pkg::core_data_req_t core_data_req;
-  magia_tile_pkg::core_data_rsp_t core_data_rsp;
+  magia_tile_pkg::core_data_req_t[magia_tile_pkg::NB_CORES-1:0] core_data_req;
+  magia_tile_pkg::core_data_rsp_t[magia_tile_pkg::NB_CORES-1:0] core_data_rsp;
 
-  magia_tile_pkg::core_obi_data_req_t core_obi_data_req;
-  magia_tile_pkg::core_obi_data_rsp_t core_obi_data_rsp;
+  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::NB_CORES-1:0] core_obi_data_req;
+  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::NB_CORES-1:0] core_obi_data_rsp;
 
   magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_SBR-1:0] core_mem_data_req; // Index 0 -> L2, Index 1 -> L1SPM, Index 2 -> RedMulE_ctrl, Index 3 -> iDMA_ctrl, Index 4 -> FSync_ctrl
   magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_SBR-1:0] core_mem_data_rsp; // Index 0 -> L2, Index 1 -> L1SPM, Index 2 -> RedMulE_ctrl, Index 3 -> iDMA_ctrl, Index 4 -> FSync_ctrl
@@ -153,26 +154,29 @@ module magia_tile
   magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_SBR-1:0] core_mem_data_cut_req; // Index 0 -> L2, Index 1 -> L1SPM
   magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_SBR-1:0] core_mem_data_cut_rsp; // Index 0 -> L2, Index 1 -> L1SPM
 
-  magia_tile_pkg::core_obi_data_req_t core_l1_data_amo_req;
-  magia_tile_pkg::core_obi_data_rsp_t core_l1_data_amo_rsp;
+  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::NB_CORES-1:0][1:0] core_demux_data_req; // Index 0 -> OBI XBAR, Index 1 -> own HCI core port
+  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::NB_CORES-1:0][1:0] core_demux_data_rsp; // Index 0 -> OBI XBAR, Index 1 -> own HCI core port
 
-  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_req; // Index 0 -> core request, Index 1 -> ext request
-  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_rsp; // Index 0 -> core request, Index 1 -> ext request
+  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_CORE-1:0] core_l1_data_amo_req; // Index 0 to NB_CORES-1 -> cores, Index NB_CORES -> OBI XBAR L1 port
+  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_CORE-1:0] core_l1_data_amo_rsp; // Index 0 to NB_CORES-1 -> cores, Index NB_CORES -> OBI XBAR L1 port
 
-  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_cut_req; // Index 0 -> core request, Index 1 -> ext request
-  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_cut_rsp; // Index 0 -> core request, Index 1 -> ext request
+  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_req; // Index 0 to NB_CORES-1 -> core requests, Index NB_CORES -> ext request, Index NB_CORES+1/+2 -> iDMA descriptor fetch
+  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_rsp; // Index 0 to NB_CORES-1 -> core requests, Index NB_CORES -> ext request, Index NB_CORES+1/+2 -> iDMA descriptor fetch
+
+  magia_tile_pkg::core_obi_data_req_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_cut_req; // Index 0 to NB_CORES-1 -> core requests, Index NB_CORES -> ext request, Index NB_CORES+1/+2 -> iDMA descriptor fetch
+  magia_tile_pkg::core_obi_data_rsp_t[magia_tile_pkg::N_MGR-1:0] obi_xbar_slv_cut_rsp; // Index 0 to NB_CORES-1 -> core requests, Index NB_CORES -> ext request, Index NB_CORES+1/+2 -> iDMA descriptor fetch
 
   magia_tile_pkg::core_obi_data_req_t ext_obi_data_req;
   magia_tile_pkg::core_obi_data_rsp_t ext_obi_data_rsp;
 
-  magia_tile_pkg::core_hci_data_req_t core_l1_data_req;
-  magia_tile_pkg::core_hci_data_rsp_t core_l1_data_rsp;
+  magia_tile_pkg::core_hci_data_req_t[magia_tile_pkg::N_CORE-1:0] core_l1_data_req; // Index 0 to NB_CORES-1 -> cores, Index NB_CORES -> OBI XBAR L1 port
+  magia_tile_pkg::core_hci_data_rsp_t[magia_tile_pkg::N_CORE-1:0] core_l1_data_rsp; // Index 0 to NB_CORES-1 -> cores, Index NB_CORES -> OBI XBAR L1 port
 
   magia_tile_pkg::core_axi_data_req_t core_l2_data_req;
   magia_tile_pkg::core_axi_data_rsp_t core_l2_data_rsp;
 
-  magia_tile_pkg::core_instr_req_t core_instr_req;
-  magia_tile_pkg::core_instr_rsp_t core_instr_rsp;
+  magia_tile_pkg::core_instr_req_t[magia_tile_pkg::NB_CORES-1:0] core_instr_req;
+  magia_tile_pkg::core_instr_rsp_t[magia_tile_pkg::NB_CORES-1:0] core_instr_rsp;
 
   magia_tile_pkg::core_cache_instr_req_t core_cache_instr_req;
   magia_tile_pkg::core_cache_instr_rsp_t core_cache_instr_rsp;
@@ -216,6 +220,10 @@ module magia_tile
   hci_package::hci_interconnect_ctrl_t hci_ctrl;  // Can be used to manage HCI control at top-level
 
   magia_tile_pkg::obi_xbar_rule_t[magia_tile_pkg::N_ADDR_RULE-1:0] obi_xbar_rule;
+  magia_tile_pkg::obi_xbar_rule_t[magia_tile_pkg::N_CORE_L1_RULE-1:0] core_l1_rule;
+
+  logic[magia_tile_pkg::NB_CORES-1:0] core_l1_dec_idx;
+  logic[magia_tile_pkg::NB_CORES-1:0] core_demux_sel;
 
   axi_pkg::xbar_rule_32_t[magia_tile_pkg::axi_xbar_cfg.NoAddrRules-1:0] axi_xbar_rule;
   
@@ -245,9 +253,18 @@ module magia_tile
   logic sys_clk;
   logic sys_clk_en;
 
-  logic[magia_pkg::N_IRQ-1:0]            irq;
+  logic[magia_tile_pkg::NB_CORES-1:0][31:0]               core_mhartid;
+  logic[magia_tile_pkg::NB_CORES-1:0]                      core_sleep;
+  logic[magia_tile_pkg::NB_CORES-1:0][63:0]               core_mcycle;
+  logic[magia_tile_pkg::NB_CORES-1:0]                      core_debug_havereset;
+  logic[magia_tile_pkg::NB_CORES-1:0]                      core_debug_running;
+  logic[magia_tile_pkg::NB_CORES-1:0]                      core_debug_halted;
+  logic[magia_tile_pkg::NB_CORES-1:0]                      core_debug_pc_valid;
+  logic[magia_tile_pkg::NB_CORES-1:0][31:0]               core_debug_pc;
+
+  logic[magia_tile_pkg::NB_CORES-1:0][magia_pkg::N_IRQ-1:0] irq;
   logic                                  redmule_busy;
-  logic[magia_tile_pkg::N_CORE-1:0][1:0] redmule_evt;
+  logic[magia_tile_pkg::NB_CORES-1:0][1:0] redmule_evt;
 
   logic                                clic_irq;
   logic[magia_tile_pkg::CLIC_ID_W-1:0] clic_irq_id;
@@ -255,8 +272,8 @@ module magia_tile
   logic[1:0]                           clic_irq_priv;
   logic                                clic_irq_shv;
 
-  logic fencei_flush_req;
-  logic fencei_flush_ack;
+  logic[magia_tile_pkg::NB_CORES-1:0] fencei_flush_req;
+  logic[magia_tile_pkg::NB_CORES-1:0] fencei_flush_ack;
 
   logic                                                                     enable_prefetching;
   snitch_icache_pkg::icache_l0_events_t[magia_tile_pkg::NR_FETCH_PORTS-1:0] icache_l0_events; // Can be used to implement i$ IRQs
@@ -266,6 +283,9 @@ module magia_tile
 
   logic fsync_clear;   // Can be used to manage iDMA clear at top-level
   logic fsync_done;
+  logic fsync_bcast;
+
+  logic noc_notify;    // Remote write to the L1 notification word of the Tile
   logic fsync_error;
 
   // iDMA transfer channel IRQ signals
@@ -277,46 +297,28 @@ module magia_tile
   logic idma_o2a_start;
   logic idma_o2a_done;
   logic idma_o2a_error;
+  logic idma_a2o_chain_done;
+  logic idma_o2a_chain_done;
 
-  // Event arrays for Event Unit (need proper 2D array structure)
-  logic [0:0] [3:0] acc_events_array;
-  logic [0:0] [1:0] dma_events_array;
-  logic [0:0] [1:0] timer_events_array;
-  logic [0:0][31:0] other_events_array;
+  // Event arrays for Event Unit (one entry per core)
+  logic [magia_tile_pkg::NB_CORES-1:0] [3:0] acc_events_array;
+  logic [magia_tile_pkg::NB_CORES-1:0] [1:0] dma_events_array;
+  logic [magia_tile_pkg::NB_CORES-1:0] [1:0] timer_events_array;
+  logic [magia_tile_pkg::NB_CORES-1:0][31:0] other_events_array;
 
   // FlooNoC connections between NI and router
   floo_req_t [4:0] floo_router_req_in;
   floo_rsp_t [4:0] floo_router_rsp_in;
   floo_req_t [4:0] floo_router_req_out;
   floo_rsp_t [4:0] floo_router_rsp_out;
-  
-  logic                           x_compressed_valid;
-  logic                           x_compressed_ready;
-  fpu_ss_pkg::x_compressed_req_t  x_compressed_req;
-  fpu_ss_pkg::x_compressed_resp_t x_compressed_resp;
-  logic                           x_issue_valid;
-  logic                           x_issue_ready;
-  fpu_ss_pkg::x_issue_req_t       x_issue_req;
-  fpu_ss_pkg::x_issue_resp_t      x_issue_resp;
-  logic                           x_commit_valid;
-  fpu_ss_pkg::x_commit_t          x_commit;
-  logic                           x_mem_valid;
-  logic                           x_mem_ready;
-  fpu_ss_pkg::x_mem_req_t         x_mem_req;
-  fpu_ss_pkg::x_mem_resp_t        x_mem_resp;
-  logic                           x_mem_result_valid;
-  fpu_ss_pkg::x_mem_result_t      x_mem_result;
-  logic                           x_result_valid;
-  logic                           x_result_ready;
-  fpu_ss_pkg::x_result_t          x_result;
-
-  // Event Unit signals - Corrected for single-core array interface
-  logic [0:0]                         eu_core_irq_req;    // [0:0] array for single core  
-  logic [0:0][magia_tile_pkg::EVENT_UNIT_IRQ_WIDTH-1:0] eu_core_irq_id;     // [0:0][4:0] array
-  logic [0:0]                         eu_core_irq_ack;    // [0:0] array
-  logic [0:0][magia_tile_pkg::EVENT_UNIT_IRQ_WIDTH-1:0] eu_core_irq_ack_id; // [0:0][4:0] array
-  logic [0:0]                         eu_core_clk_en;     // [0:0] array
-  logic [0:0]                         eu_core_dbg_req;    // [0:0] array
+
+  // Event Unit signals - one entry per core
+  logic [magia_tile_pkg::NB_CORES-1:0]                                      eu_core_irq_req;
+  logic [magia_tile_pkg::NB_CORES-1:0][magia_tile_pkg::EVENT_UNIT_IRQ_WIDTH-1:0] eu_core_irq_id;
+  logic [magia_tile_pkg::NB_CORES-1:0]                                      eu_core_irq_ack;
+  logic [magia_tile_pkg::NB_CORES-1:0][magia_tile_pkg::EVENT_UNIT_IRQ_WIDTH-1:0] eu_core_irq_ack_id;
+  logic [magia_tile_pkg::NB_CORES-1:0]                                      eu_core_clk_en;
+  logic [magia_tile_pkg::NB_CORES-1:0]                                      eu_core_dbg_req;
 
 /*******************************************************/
 /**          Internal Signal Definitions End          **/
@@ -328,6 +330,7 @@ module magia_tile
   assign tile_l1_end_addr         = magia_tile_pkg::L1_ADDR_END         + mhartid_i*magia_tile_pkg::L1_TILE_OFFSET;
   assign tile_reserved_start_addr = magia_tile_pkg::RESERVED_ADDR_START + mhartid_i*magia_tile_pkg::L1_TILE_OFFSET;
   assign tile_reserved_end_addr   = magia_tile_pkg::RESERVED_ADDR_END   + mhartid_i*magia_tile_pkg::L1_TILE_OFFSET;
+  assign tile_l1_notify_addr      = magia_tile_pkg::L1_NOTIFY_ADDR      + mhartid_i*magia_tile_pkg::L1_TILE_OFFSET;
   assign tile_redmule_ctrl_start_addr = magia_tile_pkg::REDMULE_CTRL_ADDR_START;
   assign tile_redmule_ctrl_end_addr   = magia_tile_pkg::REDMULE_CTRL_ADDR_END;
   assign tile_idma_ctrl_start_addr = magia_tile_pkg::IDMA_CTRL_ADDR_START;
@@ -346,6 +349,10 @@ module magia_tile
   assign obi_xbar_rule[magia_tile_pkg::FSYNC_CTRL_IDX] = '{idx: 32'd4, start_addr: tile_fsync_ctrl_start_addr,     end_addr: tile_fsync_ctrl_end_addr       };
   assign obi_xbar_rule[magia_tile_pkg::EVENT_UNIT_IDX] = '{idx: 32'd5, start_addr: tile_event_unit_start_addr,     end_addr: tile_event_unit_end_addr       };
 
+  assign core_l1_rule[0] = '{idx: 32'd1, start_addr: tile_l1_start_addr,               end_addr: tile_l1_end_addr               };
+  assign core_l1_rule[1] = '{idx: 32'd1, start_addr: tile_reserved_start_addr,         end_addr: tile_reserved_end_addr         };
+  assign core_l1_rule[2] = '{idx: 32'd1, start_addr: magia_tile_pkg::STACK_ADDR_START, end_addr: magia_tile_pkg::STACK_ADDR_END };
+
 
   assign axi_xbar_rule[magia_tile_pkg::L2_IDX]       = '{idx: 32'd0, start_addr: magia_tile_pkg::L2_ADDR_START, end_addr: magia_tile_pkg::L2_ADDR_END };
   assign axi_xbar_rule[magia_tile_pkg::L1SPM_IDX]    = '{idx: 32'd1, start_addr: tile_l1_start_addr,            end_addr: tile_l1_end_addr            };
@@ -361,10 +368,15 @@ module magia_tile
   assign axi_xbar_data_in_req[magia_tile_pkg::AXI_CORE_INSTR_IDX] = core_l2_instr_req;
   assign core_l2_instr_rsp                                        = axi_xbar_data_in_rsp[magia_tile_pkg::AXI_CORE_INSTR_IDX];
 
-  assign obi_xbar_slv_req[magia_tile_pkg::OBI_CORE_IDX] = core_obi_data_req;
-  assign core_obi_data_rsp                              = obi_xbar_slv_rsp[magia_tile_pkg::OBI_CORE_IDX];
-  assign obi_xbar_slv_req[magia_tile_pkg::OBI_EXT_IDX]  = ext_obi_data_req;
-  assign ext_obi_data_rsp                               = obi_xbar_slv_rsp[magia_tile_pkg::OBI_EXT_IDX];
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_obi_xbar_core
+    assign obi_xbar_slv_req[magia_tile_pkg::OBI_XBAR_CORE_IDX+i]       = core_demux_data_req[i][magia_tile_pkg::CORE_DEMUX_XBAR_IDX];
+    assign core_demux_data_rsp[i][magia_tile_pkg::CORE_DEMUX_XBAR_IDX] = obi_xbar_slv_rsp[magia_tile_pkg::OBI_XBAR_CORE_IDX+i];
+    assign core_l1_data_amo_req[i]                                     = core_demux_data_req[i][magia_tile_pkg::CORE_DEMUX_L1_IDX];
+    assign core_demux_data_rsp[i][magia_tile_pkg::CORE_DEMUX_L1_IDX]   = core_l1_data_amo_rsp[i];
+  end
+  assign obi_xbar_slv_req[magia_tile_pkg::OBI_XBAR_EXT_IDX] = ext_obi_data_req;
+  assign ext_obi_data_rsp                                   = obi_xbar_slv_rsp[magia_tile_pkg::OBI_XBAR_EXT_IDX];
+  // iDMA descriptor fetch ports are driven directly by idma_ctrl_mm (OBI_XBAR_DESC_IDX and OBI_XBAR_DESC_IDX+1)
 
   assign axi_data_user     = '0;
   assign obi_rsp_data_user = '0;
@@ -395,16 +407,31 @@ module magia_tile
 
   // Event Unit provides unified interrupt management
   // External interrupts must be mapped to bit 11 (MEIE - Machine External Interrupt Enable)
-  assign irq[magia_pkg::N_IRQ-1:12] = '0;   // Clear all high IRQs
-  assign irq[11] = eu_core_irq_req[0];      // Event Unit IRQ mapped to external interrupt (bit 11)
-  assign irq[10:8] = '0;                    // Clear IRQs 8-10
-  assign irq[7] = 1'b0;                     // Timer interrupt (unused)
-  assign irq[6:4] = '0;                     // Clear IRQs 4-6
-  assign irq[3] = 1'b0;                     // Software interrupt (unused)
-  assign irq[2:0] = '0;                     // Clear IRQs 0-2
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_core_irq
+    assign irq[i][magia_pkg::N_IRQ-1:12] = '0;   // Clear all high IRQs
+    assign irq[i][11] = eu_core_irq_req[i];      // Event Unit IRQ of core i mapped to external interrupt (bit 11)
+    assign irq[i][10:8] = '0;                    // Clear IRQs 8-10
+    assign irq[i][7] = 1'b0;                     // Timer interrupt (unused)
+    assign irq[i][6:4] = '0;                     // Clear IRQs 4-6
+    assign irq[i][3] = 1'b0;                     // Software interrupt (unused)
+    assign irq[i][2:0] = '0;                     // Clear IRQs 0-2
+
+    // Core index in the mhartid LSBs, Tile ID above them (CORE_ID_W = 0 for single-core Tiles)
+    assign core_mhartid[i] = (mhartid_i << magia_tile_pkg::CORE_ID_W) | i;
+  end
+
+  assign eu_core_irq_ack    = '0;  // Disable auto-ack to prevent IRQ loops
+  assign eu_core_irq_ack_id = '0;  // Clear ack ID - software must handle ack via register writes
 
-  assign eu_core_irq_ack[0] = 1'b0;     // Disable auto-ack to prevent IRQ loops
-  assign eu_core_irq_ack_id[0] = 5'b0;  // Clear ack ID - software must handle ack via register writes
+  assign core_sleep_o = &core_sleep; // The Tile sleeps when all of its cores do
+
+  // Cycle count and debug status are reported for core 0
+  assign mcycle_o          = core_mcycle[0];
+  assign debug_havereset_o = core_debug_havereset[0];
+  assign debug_running_o   = core_debug_running[0];
+  assign debug_halted_o    = core_debug_halted[0];
+  assign debug_pc_valid_o  = core_debug_pc_valid[0];
+  assign debug_pc_o        = core_debug_pc[0];
 
 
   // CLIC unused
@@ -415,8 +442,8 @@ module magia_tile
   assign clic_irq_shv   = 1'b0;
 
   assign enable_prefetching = 1'b0;
-  assign flush_valid[0]     = fencei_flush_req; // Single port i$
-  assign fencei_flush_ack   = flush_ready[0];   // Signle port i$
+  assign flush_valid        = fencei_flush_req; // One i$ port per core
+  assign fencei_flush_ack   = flush_ready;      // One i$ port per core
 
 
 
@@ -426,31 +453,35 @@ module magia_tile
 /**             Type Conversions Beginning            **/
 /*******************************************************/
 
-  data2obi_req i_core_data2obi_req (
-    .data_req_i ( core_data_req     ),
-    .obi_req_o  ( core_obi_data_req )
-  );
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_core_data_conv
+    data2obi_req i_core_data2obi_req (
+      .data_req_i ( core_data_req[i]     ),
+      .obi_req_o  ( core_obi_data_req[i] )
+    );
 
-  obi2data_rsp i_core_obi2data_rsp (
-    .obi_rsp_i  ( core_obi_data_rsp ),
-    .data_rsp_o ( core_data_rsp     )
-  );
+    obi2data_rsp i_core_obi2data_rsp (
+      .obi_rsp_i  ( core_obi_data_rsp[i] ),
+      .data_rsp_o ( core_data_rsp[i]     )
+    );
+  end
   
-  obi2hci_req #(
-    .obi_req_t ( magia_tile_pkg::core_obi_data_req_t ),
-    .hic_req_t ( magia_tile_pkg::core_hci_data_req_t )
-  ) i_core_data_obi2hci_req (
-    .obi_req_i ( core_l1_data_amo_req ),
-    .hci_req_o ( core_l1_data_req     )
-  );
+  for (genvar i = 0; i < magia_tile_pkg::N_CORE; i++) begin: gen_core_l1_conv
+    obi2hci_req #(
+      .obi_req_t ( magia_tile_pkg::core_obi_data_req_t ),
+      .hic_req_t ( magia_tile_pkg::core_hci_data_req_t )
+    ) i_core_data_obi2hci_req (
+      .obi_req_i ( core_l1_data_amo_req[i] ),
+      .hci_req_o ( core_l1_data_req[i]     )
+    );
 
-  hci2obi_rsp #(
-    .hci_rsp_t ( magia_tile_pkg::core_hci_data_rsp_t ),
-    .obi_rsp_t ( magia_tile_pkg::core_obi_data_rsp_t )
-  ) i_core_data_hci2obi_rsp (
-    .hci_rsp_i ( core_l1_data_rsp     ),
-    .obi_rsp_o ( core_l1_data_amo_rsp )
-  );
+    hci2obi_rsp #(
+      .hci_rsp_t ( magia_tile_pkg::core_hci_data_rsp_t ),
+      .obi_rsp_t ( magia_tile_pkg::core_obi_data_rsp_t )
+    ) i_core_data_hci2obi_rsp (
+      .hci_rsp_i ( core_l1_data_rsp[i]     ),
+      .obi_rsp_o ( core_l1_data_amo_rsp[i] )
+    );
+  end
 
   obi_to_axi #(
     .ObiCfg       ( magia_tile_pkg::obi_amo_cfg         ),
@@ -566,6 +597,12 @@ module magia_tile
     .rsp_r_user_i           ( axi2obi_rsp_r_user                            )
   );
 
+  // NoC notification: a write coming from the NoC (e.g. the last job of a remote iDMA put) to the
+  // L1 notification word pulses an event. The write still lands in L1, where it carries the sender ID.
+  // Transactions are serialized by the AXI-to-OBI bridge, so the data written before it is already in L1.
+  assign noc_notify = ext_obi_data_req.req && ext_obi_data_rsp.gnt && ext_obi_data_req.a.we &&
+                      (ext_obi_data_req.a.addr[magia_pkg::ADDR_W-1:2] == tile_l1_notify_addr[magia_pkg::ADDR_W-1:2]);
+
   // RedMule controller OBI-to-HWPE control interface
   obi2hwpe_ctrl obi2hwpe_ctrl_inst (
     .obi_req_i  ( core_mem_data_req[2]                       ),     
@@ -645,43 +682,15 @@ module magia_tile
 
 
 
-  cv32e40x_if_xif #(
-    .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
-    .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
-    .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
-    .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
-    .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
-    .X_MISA      ( magia_tile_pkg::X_MISA   ),
-    .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
-  ) xif_fpu_if ();
-  
-  cv32e40x_if_xif #(
-    .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
-    .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
-    .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
-    .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
-    .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
-    .X_MISA      ( magia_tile_pkg::X_MISA   ),
-    .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
-  ) xif_if ();
-
-  cv32e40x_if_xif #(
-    .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
-    .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
-    .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
-    .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
-    .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
-    .X_MISA      ( magia_tile_pkg::X_MISA   ),
-    .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
-  ) xif_coproc_if[magia_tile_pkg::N_COPROC] (); // Index 0 -> FPU 
-
 /*******************************************************/
 /**             Interface Definitions End             **/
 /*******************************************************/
 /**          Interface Assignments Beginning          **/
 /*******************************************************/
 
-  `HCI_ASSIGN_TO_INTF(hci_core_if[0],                                   core_l1_data_req,   core_l1_data_rsp)   // Only 1 core supported
+  for (genvar i = 0; i < magia_tile_pkg::N_CORE; i++) begin: gen_hci_core_intf
+    `HCI_ASSIGN_TO_INTF(hci_core_if[i],                                 core_l1_data_req[i], core_l1_data_rsp[i]) // 1 port per core + the OBI XBAR L1 port
+  end
   `HCI_ASSIGN_TO_INTF(hci_redmule_if[0],                                redmule_data_req,   redmule_data_rsp)   // Only 1 RedMulE supported
   `HCI_ASSIGN_TO_INTF(hci_dma_if[magia_tile_pkg::HCI_DMA_CH_READ_IDX],  idma_hci_read_req,  idma_hci_read_rsp)  // iDMA HCI read channel
   `HCI_ASSIGN_TO_INTF(hci_dma_if[magia_tile_pkg::HCI_DMA_CH_WRITE_IDX], idma_hci_write_req, idma_hci_write_rsp) // iDMA HCI write channel
@@ -697,7 +706,7 @@ module magia_tile
 
   redmule_top #(
     .ID_WIDTH           ( magia_tile_pkg::REDMULE_ID_W       ),
-    .N_CORES            ( magia_tile_pkg::N_CORE             ),
+    .N_CORES            ( magia_tile_pkg::NB_CORES           ),
     .DW                 ( magia_tile_pkg::REDMULE_DW         ),
     .UW                 ( magia_tile_pkg::REDMULE_UW         ),
     .X_EXT              ( 1'b0                               ), // RedMulE does not implement the eXtension Interface (X) - using HWPE-CTRL mode
@@ -731,111 +740,242 @@ module magia_tile
   // Documentation of cv32e40x_core's design parameters and interface is available at:
   // https://docs.openhwgroup.org/projects/cv32e40x-user-manual/en/latest/integration.html#core-integration
 
+  // Every core owns its eXtension interface, Xif dispatcher and FPU
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_core
+
+    logic                           x_compressed_valid;
+    logic                           x_compressed_ready;
+    fpu_ss_pkg::x_compressed_req_t  x_compressed_req;
+    fpu_ss_pkg::x_compressed_resp_t x_compressed_resp;
+    logic                           x_issue_valid;
+    logic                           x_issue_ready;
+    fpu_ss_pkg::x_issue_req_t       x_issue_req;
+    fpu_ss_pkg::x_issue_resp_t      x_issue_resp;
+    logic                           x_commit_valid;
+    fpu_ss_pkg::x_commit_t          x_commit;
+    logic                           x_mem_valid;
+    logic                           x_mem_ready;
+    fpu_ss_pkg::x_mem_req_t         x_mem_req;
+    fpu_ss_pkg::x_mem_resp_t        x_mem_resp;
+    logic                           x_mem_result_valid;
+    fpu_ss_pkg::x_mem_result_t      x_mem_result;
+    logic                           x_result_valid;
+    logic                           x_result_ready;
+    fpu_ss_pkg::x_result_t          x_result;
+
+    cv32e40x_if_xif #(
+      .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
+      .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
+      .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
+      .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
+      .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
+      .X_MISA      ( magia_tile_pkg::X_MISA   ),
+      .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
+    ) xif_fpu_if ();
+
+    cv32e40x_if_xif #(
+      .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
+      .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
+      .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
+      .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
+      .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
+      .X_MISA      ( magia_tile_pkg::X_MISA   ),
+      .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
+    ) xif_if ();
+
+    cv32e40x_if_xif #(
+      .X_NUM_RS    ( magia_tile_pkg::X_NUM_RS ),
+      .X_ID_WIDTH  ( magia_tile_pkg::X_ID_W   ),
+      .X_MEM_WIDTH ( magia_tile_pkg::X_MEM_W  ),
+      .X_RFR_WIDTH ( magia_tile_pkg::X_RFR_W  ),
+      .X_RFW_WIDTH ( magia_tile_pkg::X_RFW_W  ),
+      .X_MISA      ( magia_tile_pkg::X_MISA   ),
+      .X_ECS_XS    ( magia_tile_pkg::X_ECS_XS )
+    ) xif_coproc_if[magia_tile_pkg::N_COPROC] (); // Index 0 -> FPU 
+
 `ifndef CORE_TRACES
-  cv32e40x_core #(
+    cv32e40x_core #(
 `else
-  cv32e40x_wrapper #(
+    cv32e40x_wrapper #(
 `endif
-    .RV32             ( CORE_ISA                        ),
-    .A_EXT            ( CORE_A                          ),
-    .B_EXT            ( CORE_B                          ),
-    .M_EXT            ( CORE_M                          ),
-    .X_EXT            ( magia_tile_pkg::X_EXT_EN        ),    // Support for eXtension Interface (X) 
-    .X_NUM_RS         ( magia_tile_pkg::X_NUM_RS        ),    // RF read ports that can be used by the eXtension interface
-    .X_ID_WIDTH       ( magia_tile_pkg::X_ID_W          ),    // ID width of eXtension interface
-    .X_MEM_WIDTH      ( magia_tile_pkg::X_MEM_W         ),    // MEM width for loads/stores of eXtension interface
-    .X_RFR_WIDTH      ( magia_tile_pkg::X_RFR_W         ),    // RF read width of eXtension interface
-    .X_RFW_WIDTH      ( magia_tile_pkg::X_RFW_W         ),    // RF write width of eXtension interface
-    .X_MISA           ( magia_tile_pkg::X_MISA          ),    // MISA extensions implemented on the eXtension interface
-    .X_ECS_XS         ( magia_tile_pkg::X_ECS_XS        ),    // Default value for mstatus.XS if X_EXT = 1
-    .NUM_MHPMCOUNTERS ( 1                               ),    // 1 MHPMCOUNTER performance counter
-    .DEBUG            ( 1                               ),    // Enable debug support
-    .DM_REGION_START  ( magia_tile_pkg::DM_REGION_START ),    // Start address of Debug Module region
-    .DM_REGION_END    ( magia_tile_pkg::DM_REGION_END   ),    // End address of Debug Module region
-    .DBG_NUM_TRIGGERS ( 1                               ),    // 1 debug trigger
-    .PMA_NUM_REGIONS  ( 0                               ),    // No PMA (Physical Memory Attribution) regions 
-    .PMA_CFG          (                                 ),    // No array of PMA configurations
-    .CLIC             ( magia_tile_pkg::CLIC_EN         ),    // Support for Smclic, Smclicshv and Smclicconfig
-    .CLIC_ID_WIDTH    ( magia_tile_pkg::CLIC_ID_W       )     // Width of clic_irq_id_i and clic_irq_id_o
-  ) i_cv32e40x_core (
-    // Clock and reset
-    .clk_i               ( sys_clk                ),
-    .rst_ni              ( rst_ni                 ),
-    .scan_cg_en_i                                  ,
-
-    // Configuration
-    .boot_addr_i                                   ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-    .mtvec_addr_i                                  ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-    .dm_halt_addr_i                                ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-    .dm_exception_addr_i                           ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-    .mhartid_i                                     ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-    .mimpid_patch_i                                ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
-
-    // Instruction memory interface
-    .instr_req_o         ( core_instr_req.req     ),
-    .instr_gnt_i         ( core_instr_rsp.gnt     ),
-    .instr_addr_o        ( core_instr_req.addr    ),
-    .instr_memtype_o     ( core_instr_req.memtype ),
-    .instr_prot_o        ( core_instr_req.prot    ),
-    .instr_dbg_o         ( core_instr_req.dbg     ),
-    .instr_rvalid_i      ( core_instr_rsp.rvalid  ),
-    .instr_rdata_i       ( core_instr_rsp.rdata   ),
-    .instr_err_i         ( core_instr_rsp.err     ),
-
-    // Data memory interface
-    .data_req_o          ( core_data_req.req      ),
-    .data_gnt_i          ( core_data_rsp.gnt      ),
-    .data_addr_o         ( core_data_req.addr     ),
-    .data_atop_o         ( core_data_req.atop     ),
-    .data_be_o           ( core_data_req.be       ),
-    .data_memtype_o      ( core_data_req.memtype  ),
-    .data_prot_o         ( core_data_req.prot     ),
-    .data_dbg_o          ( core_data_req.dbg      ),
-    .data_wdata_o        ( core_data_req.wdata    ),
-    .data_we_o           ( core_data_req.we       ),
-    .data_rvalid_i       ( core_data_rsp.rvalid   ),
-    .data_rdata_i        ( core_data_rsp.rdata    ),
-    .data_err_i          ( core_data_rsp.err      ),
-    .data_exokay_i       ( core_data_rsp.exokay   ),
-
-    // Cycle, Time
-    .mcycle_o                                      ,
-    .time_i                                        ,
-
-    // eXtension interface
-    .xif_compressed_if   ( xif_if.cpu_compressed  ),
-    .xif_issue_if        ( xif_if.cpu_issue       ),
-    .xif_commit_if       ( xif_if.cpu_commit      ),
-    .xif_mem_if          ( xif_if.cpu_mem         ),
-    .xif_mem_result_if   ( xif_if.cpu_mem_result  ),
-    .xif_result_if       ( xif_if.cpu_result      ),
-
-     // Interrupt interface
-    .irq_i               ( irq                    ),
-
-    .clic_irq_i          ( clic_irq               ),
-    .clic_irq_id_i       ( clic_irq_id            ),
-    .clic_irq_level_i    ( clic_irq_level         ),
-    .clic_irq_priv_i     ( clic_irq_priv          ),
-    .clic_irq_shv_i      ( clic_irq_shv           ),
-
-    // Fence.i flush handshake
-    .fencei_flush_req_o  ( fencei_flush_req       ), 
-    .fencei_flush_ack_i  ( fencei_flush_ack       ),
-
-    // Debug interface
-    .debug_req_i                                   ,
-    .debug_havereset_o                             ,
-    .debug_running_o                               ,
-    .debug_halted_o                                ,
-    .debug_pc_valid_o                              ,
-    .debug_pc_o                                    ,
-
-    // Special control signals
-    .fetch_enable_i                                ,
-    .core_sleep_o                                  ,
-    .wu_wfe_i                          ( eu_core_irq_req[0] ) // Connect EU IRQ to WFE wake-up
-  );
+      .RV32             ( CORE_ISA                        ),
+      .A_EXT            ( CORE_A                          ),
+      .B_EXT            ( CORE_B                          ),
+      .M_EXT            ( CORE_M                          ),
+      .X_EXT            ( magia_tile_pkg::X_EXT_EN        ),    // Support for eXtension Interface (X) 
+      .X_NUM_RS         ( magia_tile_pkg::X_NUM_RS        ),    // RF read ports that can be used by the eXtension interface
+      .X_ID_WIDTH       ( magia_tile_pkg::X_ID_W          ),    // ID width of eXtension interface
+      .X_MEM_WIDTH      ( magia_tile_pkg::X_MEM_W         ),    // MEM width for loads/stores of eXtension interface
+      .X_RFR_WIDTH      ( magia_tile_pkg::X_RFR_W         ),    // RF read width of eXtension interface
+      .X_RFW_WIDTH      ( magia_tile_pkg::X_RFW_W         ),    // RF write width of eXtension interface
+      .X_MISA           ( magia_tile_pkg::X_MISA          ),    // MISA extensions implemented on the eXtension interface
+      .X_ECS_XS         ( magia_tile_pkg::X_ECS_XS        ),    // Default value for mstatus.XS if X_EXT = 1
+      .NUM_MHPMCOUNTERS ( 1                               ),    // 1 MHPMCOUNTER performance counter
+      .DEBUG            ( 1                               ),    // Enable debug support
+      .DM_REGION_START  ( magia_tile_pkg::DM_REGION_START ),    // Start address of Debug Module region
+      .DM_REGION_END    ( magia_tile_pkg::DM_REGION_END   ),    // End address of Debug Module region
+      .DBG_NUM_TRIGGERS ( 1                               ),    // 1 debug trigger
+      .PMA_NUM_REGIONS  ( 0                               ),    // No PMA (Physical Memory Attribution) regions 
+      .PMA_CFG          (                                 ),    // No array of PMA configurations
+      .CLIC             ( magia_tile_pkg::CLIC_EN         ),    // Support for Smclic, Smclicshv and Smclicconfig
+      .CLIC_ID_WIDTH    ( magia_tile_pkg::CLIC_ID_W       )     // Width of clic_irq_id_i and clic_irq_id_o
+    ) i_cv32e40x_core (
+      // Clock and reset
+      .clk_i               ( sys_clk                ),
+      .rst_ni              ( rst_ni                 ),
+      .scan_cg_en_i                                  ,
+
+      // Configuration
+      .boot_addr_i                                   ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+      .mtvec_addr_i                                  ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+      .dm_halt_addr_i                                ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+      .dm_exception_addr_i                           ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+      .mhartid_i           ( core_mhartid[i]        ),  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+      .mimpid_patch_i                                ,  // instead of exposing these outside the tile, they could be managed with a configuration ROM/RAM
+
+      // Instruction memory interface
+      .instr_req_o         ( core_instr_req[i].req     ),
+      .instr_gnt_i         ( core_instr_rsp[i].gnt     ),
+      .instr_addr_o        ( core_instr_req[i].addr    ),
+      .instr_memtype_o     ( core_instr_req[i].memtype ),
+      .instr_prot_o        ( core_instr_req[i].prot    ),
+      .instr_dbg_o         ( core_instr_req[i].dbg     ),
+      .instr_rvalid_i      ( core_instr_rsp[i].rvalid  ),
+      .instr_rdata_i       ( core_instr_rsp[i].rdata   ),
+      .instr_err_i         ( core_instr_rsp[i].err     ),
+
+      // Data memory interface
+      .data_req_o          ( core_data_req[i].req      ),
+      .data_gnt_i          ( core_data_rsp[i].gnt      ),
+      .data_addr_o         ( core_data_req[i].addr     ),
+      .data_atop_o         ( core_data_req[i].atop     ),
+      .data_be_o           ( core_data_req[i].be       ),
+      .data_memtype_o      ( core_data_req[i].memtype  ),
+      .data_prot_o         ( core_data_req[i].prot     ),
+      .data_dbg_o          ( core_data_req[i].dbg      ),
+      .data_wdata_o        ( core_data_req[i].wdata    ),
+      .data_we_o           ( core_data_req[i].we       ),
+      .data_rvalid_i       ( core_data_rsp[i].rvalid   ),
+      .data_rdata_i        ( core_data_rsp[i].rdata    ),
+      .data_err_i          ( core_data_rsp[i].err      ),
+      .data_exokay_i       ( core_data_rsp[i].exokay   ),
+
+      // Cycle, Time
+      .mcycle_o            ( core_mcycle[i]         ),
+      .time_i                                        ,
+
+      // eXtension interface
+      .xif_compressed_if   ( xif_if.cpu_compressed  ),
+      .xif_issue_if        ( xif_if.cpu_issue       ),
+      .xif_commit_if       ( xif_if.cpu_commit      ),
+      .xif_mem_if          ( xif_if.cpu_mem         ),
+      .xif_mem_result_if   ( xif_if.cpu_mem_result  ),
+      .xif_result_if       ( xif_if.cpu_result      ),
+
+       // Interrupt interface
+      .irq_i               ( irq[i]                 ),
+
+      .clic_irq_i          ( clic_irq               ),
+      .clic_irq_id_i       ( clic_irq_id            ),
+      .clic_irq_level_i    ( clic_irq_level         ),
+      .clic_irq_priv_i     ( clic_irq_priv          ),
+      .clic_irq_shv_i      ( clic_irq_shv           ),
+
+      // Fence.i flush handshake
+      .fencei_flush_req_o  ( fencei_flush_req[i]    ),
+      .fencei_flush_ack_i  ( fencei_flush_ack[i]    ),
+
+      // Debug interface
+      .debug_req_i                                   ,
+      .debug_havereset_o   ( core_debug_havereset[i] ),
+      .debug_running_o     ( core_debug_running[i]  ),
+      .debug_halted_o      ( core_debug_halted[i]   ),
+      .debug_pc_valid_o    ( core_debug_pc_valid[i] ),
+      .debug_pc_o          ( core_debug_pc[i]       ),
+
+      // Special control signals
+      .fetch_enable_i                                ,
+      .core_sleep_o        ( core_sleep[i]          ),
+      .wu_wfe_i            ( eu_core_irq_req[i]     )   // Connect the EU IRQ of core i to its WFE wake-up
+    );
+
+    xif_inst_dispatcher #(
+      .N_COPROC        ( magia_tile_pkg::N_COPROC        ),
+      .N_RULES         ( magia_tile_pkg::N_RULES         ),
+      .DEFAULT_IDX     ( magia_tile_pkg::DEFAULT_IDX     ),
+      .OPCODE_OFF      ( magia_tile_pkg::OPCODE_OFF      ),
+      .OPCODE_W        ( magia_tile_pkg::OPCODE_W        ),
+      .xif_inst_rule_t ( magia_tile_pkg::xif_inst_rule_t )
+    ) i_xif_inst_dispatcher (
+      .clk_i           ( sys_clk                 ),
+      .rst_ni          ( rst_ni                  ),
+      .xif_issue_if_i  ( xif_if.coproc_issue     ),
+      .xif_issue_if_o  ( xif_coproc_if.cpu_issue ),
+      .xif_result_if_o ( xif_if.coproc_result    ),
+      .xif_result_if_i ( xif_fpu_if.cpu_result   ),
+      .rules_i         ( '0                      )  // No custom rules - FPU handles all
+    );
+
+    fpu_ss #(
+      .PULP_ZFINX         ( magia_tile_pkg::FPU_ZFINX          ),
+      .INPUT_BUFFER_DEPTH ( magia_tile_pkg::FPU_BUFFER_DEPTH   ),
+      .OUT_OF_ORDER       ( magia_tile_pkg::FPU_OOO            ),
+      .FORWARDING         ( magia_tile_pkg::FPU_FWD            ),
+      .PulpDivsqrt        ( magia_tile_pkg::FPU_DIVSQRT        ),
+      .FPU_FEATURES       ( magia_tile_pkg::FPU_FEATURES       ),
+      .FPU_IMPLEMENTATION ( magia_tile_pkg::FPU_IMPLEMENTATION )
+    ) i_fpu (
+      .clk_i                ( sys_clk            ),
+      .rst_ni               ( rst_ni             ),
+      .x_compressed_valid_i ( x_compressed_valid ),
+      .x_compressed_ready_o ( x_compressed_ready ),
+      .x_compressed_req_i   ( x_compressed_req   ),
+      .x_compressed_resp_o  ( x_compressed_resp  ),
+      .x_issue_valid_i      ( x_issue_valid      ),
+      .x_issue_ready_o      ( x_issue_ready      ),
+      .x_issue_req_i        ( x_issue_req        ),
+      .x_issue_resp_o       ( x_issue_resp       ),
+      .x_commit_valid_i     ( x_commit_valid     ),
+      .x_commit_i           ( x_commit           ),
+      .x_mem_valid_o        ( x_mem_valid        ),
+      .x_mem_ready_i        ( x_mem_ready        ),
+      .x_mem_req_o          ( x_mem_req          ),
+      .x_mem_resp_i         ( x_mem_resp         ),
+      .x_mem_result_valid_i ( x_mem_result_valid ),
+      .x_mem_result_i       ( x_mem_result       ),
+      .x_result_valid_o     ( x_result_valid     ),
+      .x_result_ready_i     ( x_result_ready     ),
+      .x_result_o           ( x_result           )
+    );
+
+    xif_if2struct i_xif_if2struct (
+      .xif_compressed_if_i  ( xif_if.coproc_compressed                                ),
+      .xif_issue_if_i       ( xif_coproc_if.coproc_issue[0]                           ),  // FPU is now index 0
+      .xif_commit_if_i      ( xif_if.coproc_commit                                    ),
+      .xif_mem_if_o         ( xif_if.coproc_mem                                       ),
+      .xif_mem_result_if_i  ( xif_if.coproc_mem_result                                ),
+      .xif_result_if_o      ( xif_fpu_if.coproc_result                                ),
+      .x_compressed_valid_o ( x_compressed_valid                                      ),
+      .x_compressed_ready_i ( x_compressed_ready                                      ),
+      .x_compressed_req_o   ( x_compressed_req                                        ),
+      .x_compressed_resp_i  ( x_compressed_resp                                       ),
+      .x_issue_valid_o      ( x_issue_valid                                           ),
+      .x_issue_ready_i      ( x_issue_ready                                           ),
+      .x_issue_req_o        ( x_issue_req                                             ),
+      .x_issue_resp_i       ( x_issue_resp                                            ),
+      .x_commit_valid_o     ( x_commit_valid                                          ),
+      .x_commit_o           ( x_commit                                                ),
+      .x_mem_valid_i        ( x_mem_valid                                             ),
+      .x_mem_ready_o        ( x_mem_ready                                             ),
+      .x_mem_req_i          ( x_mem_req                                               ),
+      .x_mem_resp_o         ( x_mem_resp                                              ),
+      .x_mem_result_valid_o ( x_mem_result_valid                                      ),
+      .x_mem_result_o       ( x_mem_result                                            ),
+      .x_result_valid_i     ( x_result_valid                                          ),
+      .x_result_ready_o     ( x_result_ready                                          ),
+      .x_result_i           ( x_result                                                )
+    );
+  end
 
 /*******************************************************/
 /**                      Core End                     **/
@@ -843,6 +983,44 @@ module magia_tile
 /**      Core Data Demuxing (OBI XBAR) Beginning      **/
 /*******************************************************/
 
+  // Each core reaches the L1 (and its stack) through its own HCI core port, the rest goes
+  // through the OBI XBAR. Atomics take the OBI XBAR L1 port too: its single ATOP resolver keeps
+  // them atomic with respect to every core, so a word updated with AMOs must be written with AMOs only.
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_core_l1_demux
+    addr_decode #(
+      .NoIndices ( 2                                  ),
+      .NoRules   ( magia_tile_pkg::N_CORE_L1_RULE     ),
+      .addr_t    ( logic[magia_pkg::ADDR_W-1:0]       ),
+      .rule_t    ( magia_tile_pkg::obi_xbar_rule_t    )
+    ) i_core_l1_decode (
+      .addr_i           ( core_obi_data_req[i].a.addr              ),
+      .addr_map_i       ( core_l1_rule                             ),
+      .idx_o            ( core_l1_dec_idx[i]                       ),
+      .dec_valid_o      (                                          ),
+      .dec_error_o      (                                          ),
+      .en_default_idx_i ( 1'b1                                     ),
+      .default_idx_i    ( 1'(magia_tile_pkg::CORE_DEMUX_XBAR_IDX) )
+    );
+
+    assign core_demux_sel[i] = core_l1_dec_idx[i] & (core_obi_data_req[i].a.a_optional.atop == '0);
+
+    obi_demux #(
+      .ObiCfg      ( magia_tile_pkg::obi_amo_cfg         ),
+      .obi_req_t   ( magia_tile_pkg::core_obi_data_req_t ),
+      .obi_rsp_t   ( magia_tile_pkg::core_obi_data_rsp_t ),
+      .NumMgrPorts ( 2                                   ),
+      .NumMaxTrans ( magia_tile_pkg::N_MAX_TRAN          )
+    ) i_core_l1_demux (
+      .clk_i             ( sys_clk                ),
+      .rst_ni            ( rst_ni                 ),
+      .sbr_port_select_i ( core_demux_sel[i]      ),
+      .sbr_port_req_i    ( core_obi_data_req[i]   ),
+      .sbr_port_rsp_o    ( core_obi_data_rsp[i]   ),
+      .mgr_ports_req_o   ( core_demux_data_req[i] ),
+      .mgr_ports_rsp_i   ( core_demux_data_rsp[i] )
+    );
+  end
+
   obi_atop_resolver #(
     .SbrPortObiCfg             ( magia_tile_pkg::obi_amo_cfg                ),
     .MgrPortObiCfg             ( obi_pkg::ObiDefaultConfig                  ),
@@ -860,8 +1038,8 @@ module magia_tile
     .testmode_i     ( test_mode_i                                  ),
     .sbr_port_req_i ( core_mem_data_req[magia_tile_pkg::L1SPM_IDX] ),
     .sbr_port_rsp_o ( core_mem_data_rsp[magia_tile_pkg::L1SPM_IDX] ),
-    .mgr_port_req_o ( core_l1_data_amo_req                         ),
-    .mgr_port_rsp_i ( core_l1_data_amo_rsp                         )
+    .mgr_port_req_o ( core_l1_data_amo_req[magia_tile_pkg::HCI_CORE_XBAR_IDX] ),
+    .mgr_port_rsp_i ( core_l1_data_amo_rsp[magia_tile_pkg::HCI_CORE_XBAR_IDX] )
   );
 
   for (genvar i = 0; i < magia_tile_pkg::N_MGR; i++) begin: gen_obi_xbar_sbr_cut
@@ -991,35 +1169,14 @@ module magia_tile
 /*******************************************************/
 /**                 L1 SPM (TCDM) End                 **/
 /*******************************************************/
-/**              Xif Dispatcher Beginning             **/
-/*******************************************************/
-
-  xif_inst_dispatcher #(
-    .N_COPROC        ( magia_tile_pkg::N_COPROC        ),
-    .N_RULES         ( magia_tile_pkg::N_RULES         ),
-    .DEFAULT_IDX     ( magia_tile_pkg::DEFAULT_IDX     ),
-    .OPCODE_OFF      ( magia_tile_pkg::OPCODE_OFF      ),
-    .OPCODE_W        ( magia_tile_pkg::OPCODE_W        ),
-    .xif_inst_rule_t ( magia_tile_pkg::xif_inst_rule_t )
-  ) i_xif_inst_dispatcher (
-    .clk_i           ( sys_clk                 ),
-    .rst_ni          ( rst_ni                  ),
-    .xif_issue_if_i  ( xif_if.coproc_issue     ),
-    .xif_issue_if_o  ( xif_coproc_if.cpu_issue ),
-    .xif_result_if_o ( xif_if.coproc_result    ),
-    .xif_result_if_i ( xif_fpu_if.cpu_result   ),
-    .rules_i         ( '0                      )  // No custom rules - FPU handles all
-  );
-
-/*******************************************************/
-/**                 Xif Dispatcher End                **/
-/*******************************************************/
 /**                   iDMA Beginning                  **/
 /*******************************************************/
 
 
   idma_ctrl_mm #(
     .ERROR_CAP         ( ERROR_CAP                         ),
+    .MAX_OUTSTANDING   ( magia_tile_pkg::iDMA_MaxOutstanding ),
+    .NUM_AX_IN_FLIGHT  ( magia_tile_pkg::iDMA_NumAxInFlight  ),
     .obi_req_t         ( magia_tile_pkg::core_obi_data_req_t ),
     .obi_rsp_t         ( magia_tile_pkg::core_obi_data_rsp_t ),
     .idma_fe_reg_req_t ( magia_tile_pkg::idma_fe_reg_req_t   ),
@@ -1050,6 +1207,12 @@ module magia_tile
     .obi_write_req_o   ( idma_obi_write_req                  ),
     .obi_write_rsp_i   ( idma_obi_write_rsp                  ),
 
+    // OBI Master Interfaces (descriptor fetch from L1)
+    .desc_a2o_obi_req_o ( obi_xbar_slv_req[magia_tile_pkg::OBI_XBAR_DESC_IDX]   ),
+    .desc_a2o_obi_rsp_i ( obi_xbar_slv_rsp[magia_tile_pkg::OBI_XBAR_DESC_IDX]   ),
+    .desc_o2a_obi_req_o ( obi_xbar_slv_req[magia_tile_pkg::OBI_XBAR_DESC_IDX+1] ),
+    .desc_o2a_obi_rsp_i ( obi_xbar_slv_rsp[magia_tile_pkg::OBI_XBAR_DESC_IDX+1] ),
+
     // Serialized IRQ outputs
     .irq_a2o_busy_o    ( idma_a2o_busy                       ),
     .irq_a2o_start_o   ( idma_a2o_start                      ),
@@ -1058,7 +1221,9 @@ module magia_tile
     .irq_o2a_busy_o    ( idma_o2a_busy                       ),
     .irq_o2a_start_o   ( idma_o2a_start                      ),
     .irq_o2a_done_o    ( idma_o2a_done                       ),
-    .irq_o2a_error_o   ( idma_o2a_error                      )
+    .irq_o2a_error_o   ( idma_o2a_error                      ),
+    .irq_a2o_chain_done_o ( idma_a2o_chain_done              ),
+    .irq_o2a_chain_done_o ( idma_o2a_chain_done              )
   );
 
   axi_rw_join #(
@@ -1270,6 +1435,7 @@ module magia_tile
     .vt_fsync_if_o  ( vt_fsync_if_o                      ),
     .vn_fsync_if_o  ( vn_fsync_if_o                      ),
     .done_o         ( fsync_done                         ),
+    .bcast_o        ( fsync_bcast                        ),
     .error_o        ( fsync_error                        )
   );
 
@@ -1280,26 +1446,32 @@ module magia_tile
 /*******************************************************/
 
   // Event array assignments for proper 2D array structure
-  assign acc_events_array[0]     = {redmule_evt[0][1], redmule_evt[0][0], redmule_busy, 1'b0};
-  assign dma_events_array[0]     = {idma_o2a_done, idma_a2o_done};
-  assign timer_events_array[0]   = 2'b00;
-  assign other_events_array[0] = {idma_o2a_busy, idma_a2o_busy, idma_o2a_start, idma_a2o_start,   // iDMA status events [31:28]
-                                    idma_o2a_error, idma_a2o_error,                                  // iDMA error events [27:26] 
-                                    fsync_error, fsync_done,                                        // Fsync events [25:24]
-                                    24'b0};                                                         // Reserved [23:0] - SW events are INTERNAL to Event Unit!
-
-  // MAGIA Event Unit - Optimized for single core interrupt management
-  // Configuration rationale for single-core system:
-  // - NB_SW_EVT=0: No software events, using only external hardware events
-  // - NB_BARR=0: No barriers needed (single core, no synchronization required)
-  // - NB_HW_MUT=0: No mutexes needed (single core, no contention)
-  // - DISP_FIFO_DEPTH=0: No task dispatcher (single core, no work distribution)
+  // Tile-level events are routed to every core: each core selects the ones it sleeps on through its own event mask
+  for (genvar i = 0; i < magia_tile_pkg::NB_CORES; i++) begin: gen_core_events
+    assign acc_events_array[i]     = {redmule_evt[0][1], redmule_evt[0][0], redmule_busy, 1'b0};
+    assign dma_events_array[i]     = {idma_o2a_done, idma_a2o_done};
+    assign timer_events_array[i]   = 2'b00;
+    assign other_events_array[i] = {idma_o2a_busy, idma_a2o_busy, idma_o2a_start, idma_a2o_start,   // iDMA status events [31:28]
+                                      idma_o2a_error, idma_a2o_error,                                  // iDMA error events [27:26] 
+                                      fsync_error, fsync_done,                                        // Fsync events [25:24]
+                                      fsync_bcast,                                                    // Fsync broadcast event [23]
+                                      noc_notify,                                                     // NoC notification event [22]
+                                      idma_o2a_chain_done, idma_a2o_chain_done,                       // iDMA descriptor chain events [21:20]
+                                      20'b0};                                                         // Reserved [19:0] - SW events are INTERNAL to Event Unit!
+  end
+
+  // MAGIA Event Unit - Sized for the NB_CORES cores of the Tile
+  // Configuration rationale:
+  // - NB_SW_EVT: 1 for a single core (unused but required), 8 when cores can signal each other
+  // - NB_BARR: No barriers with a single core, HW barriers for the parallel runtime otherwise
+  // - NB_HW_MUT=0: No mutexes needed (atomics on L1 cover the shared data)
+  // - DISP_FIFO_DEPTH=0: No task dispatcher (work is split statically by the cores)
   // Result: Minimal resource usage while preserving interrupt prioritization and management
   magia_event_unit #(
-    .NB_CORES         ( 1                                          ), // Single core system
-    .NB_SW_EVT        ( 1                                          ), // Minimum 1 SW event to avoid indexing issues (unused but required)
-    .NB_BARR          ( 0                                          ), // No barriers needed with single core
-    .NB_HW_MUT        ( 0                                          ), // No mutexes needed with single core  
+    .NB_CORES         ( magia_tile_pkg::NB_CORES                   ), // Cores of the Tile
+    .NB_SW_EVT        ( magia_tile_pkg::EU_NB_SW_EVT               ), // Minimum 1 SW event to avoid indexing issues
+    .NB_BARR          ( magia_tile_pkg::EU_NB_BARR                 ), // HW barriers only with more than one core
+    .NB_HW_MUT        ( 0                                          ), // No mutexes needed
     .MUTEX_MSG_W      ( 32                                         ), // Keep default even if unused
     .DISP_FIFO_DEPTH  ( 0                                          ), // No task dispatcher needed
     .EVNT_WIDTH       ( 8                                          ), // SOC event width (keep default)
@@ -1309,7 +1481,7 @@ module magia_tile
     .rst_ni           ( rst_ni                                     ),
     .test_mode_i      ( test_mode_i                                ),
 
-    // Event inputs - single core arrays
+    // Event inputs - per-core arrays
     .acc_events_i     ( acc_events_array     ),                    // Accelerator events
     .dma_events_i     ( dma_events_array     ),                    // iDMA completion events  
     .timer_events_i   ( timer_events_array   ),
@@ -1322,11 +1494,11 @@ module magia_tile
     .core_irq_ack_id_i( eu_core_irq_ack_id                         ),
 
     // Core control
-    .core_busy_i      ( ~core_sleep_o                              ),
+    .core_busy_i      ( ~core_sleep                                ),
     .core_clock_en_o  ( eu_core_clk_en                             ),
 
     // Debug
-    .dbg_req_i        ( debug_req_i                                ),
+    .dbg_req_i        ( {magia_tile_pkg::NB_CORES{debug_req_i}}    ),
     .core_dbg_req_o   ( eu_core_dbg_req                            ),
 
     // OBI Interface - Direct Connection
@@ -1337,71 +1509,5 @@ module magia_tile
 /*******************************************************/
 /**                    Event Unit End                 **/
 /*******************************************************/
-/**           Floating-Point Unit Beginning           **/
-/*******************************************************/
-
-  fpu_ss #(
-    .PULP_ZFINX         ( magia_tile_pkg::FPU_ZFINX          ),
-    .INPUT_BUFFER_DEPTH ( magia_tile_pkg::FPU_BUFFER_DEPTH   ),
-    .OUT_OF_ORDER       ( magia_tile_pkg::FPU_OOO            ),
-    .FORWARDING         ( magia_tile_pkg::FPU_FWD            ),
-    .PulpDivsqrt        ( magia_tile_pkg::FPU_DIVSQRT        ),
-    .FPU_FEATURES       ( magia_tile_pkg::FPU_FEATURES       ),
-    .FPU_IMPLEMENTATION ( magia_tile_pkg::FPU_IMPLEMENTATION )
-  ) i_fpu (
-    .clk_i                ( sys_clk            ),
-    .rst_ni               ( rst_ni             ),
-    .x_compressed_valid_i ( x_compressed_valid ),
-    .x_compressed_ready_o ( x_compressed_ready ),
-    .x_compressed_req_i   ( x_compressed_req   ),
-    .x_compressed_resp_o  ( x_compressed_resp  ),
-    .x_issue_valid_i      ( x_issue_valid      ),
-    .x_issue_ready_o      ( x_issue_ready      ),
-    .x_issue_req_i        ( x_issue_req        ),
-    .x_issue_resp_o       ( x_issue_resp       ),
-    .x_commit_valid_i     ( x_commit_valid     ),
-    .x_commit_i           ( x_commit           ),
-    .x_mem_valid_o        ( x_mem_valid        ),
-    .x_mem_ready_i        ( x_mem_ready        ),
-    .x_mem_req_o          ( x_mem_req          ),
-    .x_mem_resp_i         ( x_mem_resp         ),
-    .x_mem_result_valid_i ( x_mem_result_valid ),
-    .x_mem_result_i       ( x_mem_result       ),
-    .x_result_valid_o     ( x_result_valid     ),
-    .x_result_ready_i     ( x_result_ready     ),
-    .x_result_o           ( x_result           )
-  );
-
-  xif_if2struct i_xif_if2struct (
-    .xif_compressed_if_i  ( xif_if.coproc_compressed                                ),
-    .xif_issue_if_i       ( xif_coproc_if.coproc_issue[0]                           ),  // FPU is now index 0
-    .xif_commit_if_i      ( xif_if.coproc_commit                                    ),
-    .xif_mem_if_o         ( xif_if.coproc_mem                                       ),
-    .xif_mem_result_if_i  ( xif_if.coproc_mem_result                                ),
-    .xif_result_if_o      ( xif_fpu_if.coproc_result                                ),
-    .x_compressed_valid_o ( x_compressed_valid                                      ),
-    .x_compressed_ready_i ( x_compressed_ready                                      ),
-    .x_compressed_req_o   ( x_compressed_req                                        ),
-    .x_compressed_resp_i  ( x_compressed_resp                                       ),
-    .x_issue_valid_o      ( x_issue_valid                                           ),
-    .x_issue_ready_i      ( x_issue_ready                                           ),
-    .x_issue_req_o        ( x_issue_req                                             ),
-    .x_issue_resp_i       ( x_issue_resp                                            ),
-    .x_commit_valid_o     ( x_commit_valid                                          ),
-    .x_commit_o           ( x_commit                                                ),
-    .x_mem_valid_i        ( x_mem_valid                                             ),
-    .x_mem_ready_o        ( x_mem_ready                                             ),
-    .x_mem_req_i          ( x_mem_req                                               ),
-    .x_mem_resp_o         ( x_mem_resp                                              ),
-    .x_mem_result_valid_o ( x_mem_result_valid                                      ),
-    .x_mem_result_o       ( x_mem_result                                            ),
-    .x_result_valid_i     ( x_result_valid                                          ),
-    .x_result_ready_o     ( x_result_ready                                          ),
-    .x_result_i           ( x_result                                                )
-  );
-
-/*******************************************************/
-/**              Floating-Point Unit End              **/
-/*******************************************************/
 
 endmodule: magia_tile
\ No newline at end of file
@@ -19,6 +19,10 @@
  * MAGIA Tile Package
  */
 
+`ifndef MAGIA_NB_CORES
+  `define MAGIA_NB_CORES 1
+`endif
+
 package magia_tile_pkg;
 
   `include "hci/typedef.svh"
@@ -59,13 +63,14 @@ package magia_tile_pkg;
   localparam logic [magia_pkg::ADDR_W-1:0] L1_SIZE                  = 32'h000D_FFFF;
   localparam logic [magia_pkg::ADDR_W-1:0] L1_ADDR_END              = L1_ADDR_START + L1_SIZE;
   localparam logic [magia_pkg::ADDR_W-1:0] L1_TILE_OFFSET           = 32'h0010_0000;
+  localparam logic [magia_pkg::ADDR_W-1:0] L1_NOTIFY_ADDR           = L1_ADDR_END - 32'h3;         // Last L1 word: a write to it from the NoC raises the notification event
   localparam logic [magia_pkg::ADDR_W-1:0] L2_ADDR_START            = 32'hC000_0000;
   localparam logic [magia_pkg::ADDR_W-1:0] L2_SIZE                  = 32'h3FFF_FFFF;
   localparam logic [magia_pkg::ADDR_W-1:0] L2_ADDR_END              = L2_ADDR_START + L2_SIZE;
 
   // Parameters used by the HCI
   parameter int unsigned N_HWPE  = 1;                                                   // Number of HWPEs attached to the port
-  parameter int unsigned N_CORE  = 1;                                                   // Number of Core ports
+  parameter int unsigned N_CORE  = `MAGIA_NB_CORES + 1;                                 // Number of Core ports (1 per Tile core + 1 for the OBI XBAR L1 port: NoC, iDMA descriptor fetch and core atomics)
   parameter int unsigned N_DMA   = 2;                                                   // Number of DMA ports (1 for the read channel and 1 for the write channel)
   typedef enum logic{
     HCI_DMA_CH_READ_IDX  = 1'b0,
@@ -94,6 +99,8 @@ package magia_tile_pkg;
   localparam int unsigned WDH    = DWH/WWH;                                             // Number of words per data for HWPE Interconnect
 
   // Parameters used by the core
+  parameter int unsigned NB_CORES        = `MAGIA_NB_CORES;                             // Number of cores in the Tile (1 to 4)
+  localparam int unsigned CORE_ID_W      = (NB_CORES > 1) ? $clog2(NB_CORES) : 0;       // Number of mhartid LSBs holding the core index within the Tile
   parameter bit          X_EXT_EN        = 1;                                           // Enable eXtension Interface (X) support, see eXtension Interface        
   parameter int unsigned X_NUM_RS        = 3;                                           // Number of register file read ports that can be used by the eXtension interface
   parameter int unsigned X_ID_W          = 4;                                           // Identification width for the eXtension interface
@@ -109,6 +116,8 @@ package magia_tile_pkg;
 
   // Parameters used by Event Unit
   parameter int unsigned EVENT_UNIT_IRQ_WIDTH = 5;                                      // Width of Event Unit IRQ ID signals (supports up to 32 different event types)
+  parameter int unsigned EU_NB_SW_EVT         = (NB_CORES > 1) ? 8 : 1;                // Number of SW events (at least 1 to avoid indexing issues)
+  parameter int unsigned EU_NB_BARR           = (NB_CORES > 1) ? 2 : 0;                // Number of HW barriers (only needed with more than one core)
 
   // Parameters used by RedMulE
   parameter int unsigned REDMULE_DW   = DWH;                                            // RedMulE Data Width
@@ -127,8 +136,8 @@ package magia_tile_pkg;
   parameter int unsigned MID_WIDTH    = 1;                                              // Width of the mid   signal (manager identifier, see OBI documentation)
   parameter int unsigned OBI_ID_WIDTH = 1;                                              // Width of the id - configuration
   parameter int unsigned N_SBR        = 6;                                              // Number of slaves (HCI, AXI XBAR, RedMulE_Ctrl, iDMA_Ctrl, FSync_Ctrl, Event_Unit)
-  parameter int unsigned N_MGR        = 2;                                              // Number of masters (Core, AXI XBAR)
-  parameter int unsigned N_MAX_TRAN   = 1;                                              // Number of maximum outstanding transactions
+  parameter int unsigned N_MGR        = NB_CORES + 3;                                   // Number of masters (Cores, AXI XBAR, iDMA descriptor fetch for each direction)
+  parameter int unsigned N_MAX_TRAN   = 2;                                              // Number of maximum outstanding transactions (the CV32E40X LSU issues up to 2)
   parameter int unsigned N_ADDR_RULE  = 8;                                              // Number of address rules (L2, L1, Stack, Reserved, RedMulE_Ctrl, iDMA_Ctrl, FSync_Ctrl, Event_Unit)
   localparam int unsigned N_BIT_SBR   = $clog2(N_SBR);                                  // Number of bits required to identify each slave
 
@@ -148,7 +157,8 @@ package magia_tile_pkg;
   parameter int unsigned iDMA_UserWidth           = AXI_DATA_U_W;                       // iDMA AXI User Width
   parameter int unsigned iDMA_StrbWidth           = magia_pkg::STRB_W;                  // iDMA AXI Strobe Width
   parameter int unsigned iDMA_AxiIdWidth          = AXI_DATA_ID_W;                      // iDMA AXI ID Width
-  parameter int unsigned iDMA_NumAxInFlight       = 2;                                  // iDMA Number of transaction that can be in-flight concurrently
+  parameter int unsigned iDMA_MaxOutstanding      = 4;                                  // iDMA Number of jobs per transfer channel issued and not yet retired (NEXT_ID/DONE_ID distance)
+  parameter int unsigned iDMA_NumAxInFlight       = iDMA_MaxOutstanding;                // iDMA Number of transaction that can be in-flight concurrently
   parameter int unsigned iDMA_BufferDepth         = 3;                                  // iDMA depth of the internal reorder buffer: '2' - minimal possible configuration; '3' - efficiently handle misaligned transfers (recommended)
   parameter int unsigned iDMA_TFLenWidth          = 32;                                 // iDMA With of a transfer: max transfer size is `2**TFLenWidth` bytes
   parameter int unsigned iDMA_MemSysDepth         = 0;                                  // iDMA depth of the memory system the backend is attached to
@@ -160,12 +170,19 @@ package magia_tile_pkg;
   parameter int unsigned iDMA_PrintFifoInfo       = 0;                                  // iDMA Print the info of the FIFO configuration
   parameter int unsigned iDMA_NumRegs             = 1;                                  // iDMA Number of configuration register ports
   parameter int unsigned iDMA_NumStreams          = 1;                                  // iDMA Number of streams (max 16)
-  parameter int unsigned iDMA_JobFifoDepth        = 2;                                  // iDMA Stream FIFO depth
+  parameter int unsigned iDMA_JobFifoDepth        = iDMA_MaxOutstanding;                // iDMA Stream FIFO depth
   parameter int unsigned iDMA_IdCounterWidth      = 32;                                 // iDMA Width of the transfer id (max 32-bit)
   parameter int unsigned iDMA_RepWidth            = 32;                                 // iDMA Width of the reps field
   localparam logic[iDMA_NumDims-1:0][31:0] 
                          iDMA_RepWidths           = '{default: 32'd32};                 // iDMA Width of the counters holding the number of repetitions
   parameter int unsigned iDMA_StrideWidth         = 32;                                 // iDMA Width of the stride field
+  localparam logic[11:0] IDMA_CHAIN_HEAD_OFFSET    = 12'h180;                           // iDMA descriptor chain: address of the first descriptor (write starts the chain)
+  localparam logic[11:0] IDMA_CHAIN_STATUS_OFFSET  = 12'h184;                           // iDMA descriptor chain: [0] busy
+  localparam logic[11:0] IDMA_CHAIN_LAST_ID_OFFSET = 12'h188;                           // iDMA descriptor chain: ID of the last job launched
+  localparam logic[11:0] IDMA_COALESCE_COUNT_OFFSET   = 12'h190;                        // iDMA completion coalescing: done event every K retired jobs (0/1 -> every job)
+  localparam logic[11:0] IDMA_COALESCE_TIMEOUT_OFFSET = 12'h194;                        // iDMA completion coalescing: done event at most N cycles after the first pending job (0 -> no timeout)
+  localparam logic[11:0] IDMA_XFORM_MODE_OFFSET       = 12'h198;                        // iDMA L1 data transform: mode (fill, FP conversion)
+  localparam logic[11:0] IDMA_XFORM_ARG_OFFSET        = 12'h19c;                        // iDMA L1 data transform: fill pattern or packed buffer address
   typedef enum logic{
     AXI2OBI = 1'b0,
     OBI2AXI = 1'b1
@@ -268,7 +285,7 @@ package magia_tile_pkg;
   parameter bit          AxiXbarSpillR         = 1'b0;                                  // Enabled -> Spill register on read master ports, +1 cycle of latency on write channels 
 
   // Parameters used by the i$
-  parameter int unsigned NR_FETCH_PORTS = 1;                                            // i$ Number of request (fetch) ports
+  parameter int unsigned NR_FETCH_PORTS = NB_CORES;                                     // i$ Number of request (fetch) ports, one per core
   parameter int unsigned L0_LINE_COUNT  = 32;                                           // i$ L0 Cache Line Count
   parameter int unsigned LINE_WIDTH     = 128;                                          // i$ Cache Line Width; >= 64
   parameter int unsigned LINE_COUNT     = 32;                                           // i$ The number of cache lines per set. Power of two; >= 2.
@@ -315,6 +332,14 @@ package magia_tile_pkg;
     OBI_CORE_IDX = 0
   } obi_xbar_idx_e;
 
+  localparam int unsigned OBI_XBAR_CORE_IDX = 0;                                        // OBI XBAR manager index of core 0 (core i is at OBI_XBAR_CORE_IDX + i)
+  localparam int unsigned OBI_XBAR_EXT_IDX  = NB_CORES;                                 // OBI XBAR manager index of the requests coming from the AXI XBAR
+  localparam int unsigned OBI_XBAR_DESC_IDX = NB_CORES + 1;                             // OBI XBAR manager index of the AXI2OBI descriptor fetch (OBI2AXI at OBI_XBAR_DESC_IDX + 1)
+  localparam int unsigned CORE_DEMUX_XBAR_IDX = 0;                                      // Core data demux output towards the OBI XBAR
+  localparam int unsigned CORE_DEMUX_L1_IDX   = 1;                                      // Core data demux output towards the core's own HCI core port
+  parameter int unsigned  N_CORE_L1_RULE      = 3;                                      // Number of address rules of the core data demux (L1, Reserved, Stack)
+  localparam int unsigned HCI_CORE_XBAR_IDX   = NB_CORES;                               // HCI core port of the OBI XBAR L1 port (core i is at HCI core port i)
+
   typedef struct packed {
     logic                         req;
     logic[magia_pkg::INSTR_W-1:0] addr;
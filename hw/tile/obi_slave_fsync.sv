@@ -19,6 +19,13 @@
  *
  * OBI Slave Fractal Sync Memory-Mapped Controller
  * Replaces XIF interface with memory-mapped register access
+ *
+ * Broadcast mode: a tile with BCAST_REG[0] set keeps a sync request armed on the
+ * (AGGR_REG, ID_REG) subtree. Any tile of that subtree issuing a regular sync with
+ * the same configuration completes the tree, and every listener gets a bcast_o pulse
+ * (instead of done_o) and re-arms automatically while BCAST_REG[0] stays set.
+ * While BCAST_REG[0] is set or a listener request is still armed, writes to AGGR_REG,
+ * ID_REG and CONTROL_REG are dropped and answered with an OBI error.
  */
 
 module obi_slave_fsync 
@@ -46,6 +53,7 @@ module obi_slave_fsync
   fractal_sync_if.mst_port     vn_fsync_if_o,
 
   output logic                 done_o,
+  output logic                 bcast_o,
   output logic                 error_o
 );
 
@@ -58,9 +66,13 @@ module obi_slave_fsync
   
   logic sync_trigger;
   logic done;
+  logic bcast;
   logic addr_match;
+  logic listen_d, listen_q;
+  logic listen_lock;
+  logic cfg_write;
 
-  logic[DATA_W-1:0] aggr_reg, id_reg, status_reg, control_reg;
+  logic[DATA_W-1:0] aggr_reg, id_reg, status_reg, control_reg, bcast_reg;
   
   typedef enum logic[1:0] {
     IDLE,
@@ -76,10 +88,12 @@ module obi_slave_fsync
   // BASE_ADDR + 0x04: ID_REG (write-only)  
   // BASE_ADDR + 0x08: CONTROL_REG (write-only, writing triggers sync)
   // BASE_ADDR + 0x0C: STATUS_REG (read-only)
-  localparam logic [ADDR_W-1:0] AGGR_REG_OFFSET    = 4'h0;
-  localparam logic [ADDR_W-1:0] ID_REG_OFFSET      = 4'h4;
-  localparam logic [ADDR_W-1:0] CONTROL_REG_OFFSET = 4'h8;
-  localparam logic [ADDR_W-1:0] STATUS_REG_OFFSET  = 4'hC;
+  // BASE_ADDR + 0x10: BCAST_REG (read-write, bit 0 = listen for broadcasts)
+  localparam logic [ADDR_W-1:0] AGGR_REG_OFFSET    = 8'h00;
+  localparam logic [ADDR_W-1:0] ID_REG_OFFSET      = 8'h04;
+  localparam logic [ADDR_W-1:0] CONTROL_REG_OFFSET = 8'h08;
+  localparam logic [ADDR_W-1:0] STATUS_REG_OFFSET  = 8'h0C;
+  localparam logic [ADDR_W-1:0] BCAST_REG_OFFSET   = 8'h10;
 
 /*******************************************************/
 /**          Internal Signal Definitions End          **/
@@ -90,13 +104,24 @@ module obi_slave_fsync
   assign addr_match = (obi_req_i.a.addr >= BASE_ADDR) && 
                       (obi_req_i.a.addr < BASE_ADDR + 32'h100);
 
+  // AGGR/ID belong to the armed listener until it is released
+  assign listen_lock = bcast_reg[0] | ((c_sync_state != IDLE) & listen_q);
+  assign cfg_write   = (obi_req_i.a.addr - BASE_ADDR == AGGR_REG_OFFSET) ||
+                       (obi_req_i.a.addr - BASE_ADDR == ID_REG_OFFSET)   ||
+                       (obi_req_i.a.addr - BASE_ADDR == CONTROL_REG_OFFSET);
+
   assign done_o  = done;
+  assign bcast_o = bcast;
   assign error_o = ht_fsync_if_o.error | hn_fsync_if_o.error | 
                    vt_fsync_if_o.error | vn_fsync_if_o.error;
 
-  // Status register: bit 0 = done, bit 1 = error, bit 2 = busy  
-  // For polling: when busy=0, operation is complete
-  assign status_reg = {29'b0, (c_sync_state == SYNC || c_sync_state == WAIT), error_o, done};
+  // Status register: bit 0 = done, bit 1 = error, bit 2 = busy, bit 3 = listening
+  // For polling: when busy=0, operation is complete (an armed broadcast listener is not busy)
+  assign status_reg = {28'b0, 
+                       (c_sync_state != IDLE) & listen_q, 
+                       (c_sync_state == SYNC || c_sync_state == WAIT) & ~listen_q, 
+                       error_o, 
+                       done};
 
 /*******************************************************/
 /**               Hardwired Signals End               **/
@@ -139,7 +164,10 @@ module obi_slave_fsync
       obi_rsp_o.r.r_optional = '0;
       obi_rsp_o.r.err = 1'b0;
       
-      if (obi_req_i.a.we) begin
+      if (obi_req_i.a.we && cfg_write && listen_lock) begin
+        // Sync configuration or trigger under an armed listener: dropped
+        obi_rsp_o.r.err = 1'b1;
+      end else if (obi_req_i.a.we) begin
         // Write operation
         case (obi_req_i.a.addr - BASE_ADDR)
           CONTROL_REG_OFFSET: begin
@@ -155,6 +183,9 @@ module obi_slave_fsync
           STATUS_REG_OFFSET: begin
             obi_rsp_o.r.rdata = status_reg;
           end
+          BCAST_REG_OFFSET: begin
+            obi_rsp_o.r.rdata = bcast_reg;
+          end
           default: begin
             obi_rsp_o.r.rdata = 32'h0;  // Return 0 for write-only registers
           end
@@ -171,13 +202,15 @@ module obi_slave_fsync
 
   always_ff @(posedge clk_reg_g, negedge rst_ni) begin: configuration_registers
     if (~rst_ni) begin
-      aggr_reg <= '0;
-      id_reg   <= '0;
+      aggr_reg  <= '0;
+      id_reg    <= '0;
+      bcast_reg <= '0;
     end else begin
       if (clear_i) begin
-        aggr_reg <= '0;
-        id_reg   <= '0;
-      end else if (obi_req_i.req && addr_match && obi_req_i.a.we) begin
+        aggr_reg  <= '0;
+        id_reg    <= '0;
+        bcast_reg <= '0;
+      end else if (obi_req_i.req && addr_match && obi_req_i.a.we && ~(cfg_write && listen_lock)) begin
         case (obi_req_i.a.addr - BASE_ADDR)
           AGGR_REG_OFFSET: begin
             aggr_reg <= obi_req_i.a.wdata;
@@ -185,6 +218,9 @@ module obi_slave_fsync
           ID_REG_OFFSET: begin
             id_reg <= obi_req_i.a.wdata;
           end
+          BCAST_REG_OFFSET: begin
+            bcast_reg <= {31'b0, obi_req_i.a.wdata[0]};
+          end
         endcase
       end
     end
@@ -198,8 +234,10 @@ module obi_slave_fsync
 
   always_comb begin: sync_logic
     n_sync_state         = c_sync_state;
+    listen_d             = listen_q;
     clk_sync_en          = 1'b1;
     done                 = 1'b0;
+    bcast                = 1'b0;
     ht_fsync_if_o.sync   = 1'b0;
     ht_fsync_if_o.aggr   = '0;
     ht_fsync_if_o.id_req = '0;
@@ -217,6 +255,10 @@ module obi_slave_fsync
       IDLE: begin
         if (sync_trigger) begin
           n_sync_state = SYNC;
+          listen_d     = 1'b0;
+        end else if (bcast_reg[0]) begin                          // (Re-)arm the broadcast listener
+          n_sync_state = SYNC;
+          listen_d     = 1'b1;
         end else begin
           clk_sync_en = 1'b0;
         end
@@ -273,7 +315,8 @@ module obi_slave_fsync
       
       DONE: begin
         n_sync_state = IDLE;
-        done         = 1'b1;
+        done         = ~listen_q;
+        bcast        =  listen_q;
       end
     endcase
   end
@@ -286,6 +329,14 @@ module obi_slave_fsync
     end
   end
 
+  always_ff @(posedge clk_sync_g, negedge rst_ni) begin: listen_state
+    if (~rst_ni)   listen_q <= 1'b0;
+    else begin
+      if (clear_i) listen_q <= 1'b0;
+      else         listen_q <= listen_d;
+    end
+  end
+
 /*******************************************************/
 /**              Synchronization FSM End              **/
 /*******************************************************/
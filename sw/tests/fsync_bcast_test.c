@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA FractalSync Broadcast Test - Event Unit Version
+ * Tile 0 publishes a value in L2 and broadcasts it over the FractalSync tree,
+ * every other tile listens and checks the value on the broadcast event.
+ * Broadcasts coalesce if sent before the previous one was consumed, so every
+ * listener acknowledges each round in the L1 of the sender before the next one
+ *
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "fsync_mm_utils.h"
+#include "fsync_mm_api.h"
+#include "event_unit_utils.h"
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+#define NUM_ROUNDS (4)
+
+#define SENDER_ID (0)
+
+// One slot per round, so that the sender never overwrites a value not yet read
+#define FLAG_BASE (L2_BASE + 0x00050000)
+
+#define FLAG_VALUE(r) (0xCAFE0000 + (r))
+
+// Acknowledgements in the L1 of the sender: one word per tile, the last round consumed + 1
+#define ACK_OFFSET  (0x00010000)
+#define ACK_ADDR(t) (L1_BASE + SENDER_ID*L1_TILE_OFFSET + ACK_OFFSET + 4*(t))
+
+static void wait_acks(uint32_t rounds) {
+  for (uint32_t t = 0; t < NUM_HARTS; t++) {
+    if (t == SENDER_ID)
+      continue;
+    while (mmio32(ACK_ADDR(t)) < rounds)
+      wait_nop(10);
+  }
+}
+
+int main(void) {
+  uint32_t tile_hartid = get_hartid();
+  uint32_t num_errors  = 0;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+
+  printf("Starting Fractal Sync broadcast test...\n");
+
+  if (tile_hartid == SENDER_ID) {
+    eu_enable_events(EU_FSYNC_DONE_MASK);
+
+    for (uint32_t t = 0; t < NUM_HARTS; t++)
+      mmio32(ACK_ADDR(t)) = 0;
+
+    for (int r = 0; r < NUM_ROUNDS; r++) {
+      // Every listener has consumed the previous broadcast
+      wait_acks(r);
+
+      mmio32(FLAG_BASE + 4*r) = FLAG_VALUE(r);
+      // Read back to make sure the value reached L2 before the broadcast
+      if (mmio32(FLAG_BASE + 4*r) != FLAG_VALUE(r))
+        num_errors++;
+
+      if (fsync_mm_bcast_global_send() != FSYNC_MM_OK)
+        num_errors++;
+
+      if (USE_WFE)
+        eu_fsync_wait_completion(EU_WAIT_MODE_WFE);
+      else
+        eu_fsync_wait_completion(EU_WAIT_MODE_POLLING);
+
+#if VERBOSE > 1
+      printf("Broadcast %0d sent...\n", r);
+#endif
+    }
+  } else {
+    fsync_mm_bcast_global_listen();
+
+    // A regular sync would overwrite the armed request: refused, nothing to wait for
+    if (fsync_mm_global() != FSYNC_MM_LISTENING)
+      num_errors++;
+
+    for (int r = 0; r < NUM_ROUNDS; r++) {
+      // Do not re-arm after the last broadcast
+      if (r == NUM_ROUNDS-1)
+        fsync_mm_bcast_stop();
+
+      if (USE_WFE)
+        eu_fsync_wait_bcast(EU_WAIT_MODE_WFE);
+      else
+        eu_fsync_wait_bcast(EU_WAIT_MODE_POLLING);
+
+      if (mmio32(FLAG_BASE + 4*r) != FLAG_VALUE(r)) {
+        num_errors++;
+        printf("**ERROR**: broadcast %0d read 0x%0x, expected 0x%0x\n", r, mmio32(FLAG_BASE + 4*r), FLAG_VALUE(r));
+      }
+#if VERBOSE > 1
+      else
+        printf("Broadcast %0d received...\n", r);
+#endif
+
+      mmio32(ACK_ADDR(tile_hartid)) = r + 1;
+    }
+  }
+
+  printf("Fractal Sync broadcast test finished with %0d error(s)...\n", num_errors);
+
+  mmio16(TEST_END_ADDR + tile_hartid*2) = (num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE) - tile_hartid;
+
+  return 0;
+}
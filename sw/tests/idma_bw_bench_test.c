@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Bandwidth Characterization using Memory-Mapped Control
+ * Sweeps configuration, direction, shape and size of the transfers and reports
+ * bytes per cycle, first on tile 0 alone and then on all tiles at once
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "fsync_mm_utils.h"
+#include "fsync_mm_api.h"
+
+// L1 side: contiguous, per tile
+#define L1_IN  (L1_BASE + 0x00020000)
+#define L1_OUT (L1_BASE + 0x00030000)
+
+// L2 side: strided for 2D/3D shapes, so twice the transfer size per buffer
+#define L2_BENCH_BASE   (L2_BASE + 0x00100000)
+#define L2_TILE_OFFSET  (0x00020000)
+#define L2_IN_OFFSET    (0x00000000)
+#define L2_OUT_OFFSET   (0x00010000)
+
+// Rows of 2D/3D shapes, L2 rows are 2*ROW_LEN apart. Sizes below one 3D plane
+// (ROW_LEN*ROWS_PER_3) are not run as 3D.
+#define ROW_LEN    (256)
+#define ROWS_PER_3 (4)
+
+// Per-tile cycles of the concurrent runs, collected by tile 0 over the NoC
+#define RESULT_OFFSET (0x00010000)
+
+#define NUM_SIZES  (4)
+#define NUM_CONFS  (5)
+#define NUM_SHAPES (3)
+
+#define DIR_BOTH (2)
+
+#define TIMEOUT_CYCLES (1000000)
+
+#define VERBOSE (0)
+
+static const uint32_t sizes[NUM_SIZES] = {256, 1024, 4096, 16384};
+
+static const char *shape_names[NUM_SHAPES] = {"1D", "2D", "3D"};
+static const char *dir_names[3]            = {"L2->L1", "L1->L2", "both"};
+
+typedef struct {
+  const char *name;
+  uint32_t    decouple_aw, decouple_rw;
+  uint32_t    src_reduce_len, dst_reduce_len;
+  uint32_t    src_max_llen, dst_max_llen;
+} bench_conf_t;
+
+static const bench_conf_t confs[NUM_CONFS] = {
+  {"default",      0, 0, 0, 0, 0, 0},
+  {"decouple",     1, 1, 0, 0, 0, 0},
+  {"reduce_len",   0, 0, 1, 1, 0, 0},
+  {"max_llen=2",   0, 0, 1, 1, 2, 2},
+  {"max_llen=4",   0, 0, 1, 1, 4, 4},
+};
+
+static void bench_set_conf(const bench_conf_t *c) {
+  uint32_t conf = idma_mm_conf_pack(c->decouple_aw, c->decouple_rw, c->src_reduce_len, c->dst_reduce_len,
+                                    c->src_max_llen, c->dst_max_llen, 3);
+  idma_mm_set_default_conf_dir(IDMA_DIR_L2_TO_L1, conf);
+  idma_mm_set_default_conf_dir(IDMA_DIR_L1_TO_L2, conf);
+}
+
+// Issues one job of the given shape: the L1 side is contiguous, the L2 side strided
+static uint32_t bench_submit(uint32_t dir, uint32_t shape, uint32_t size, uint32_t l1, uint32_t l2) {
+  uint32_t l1_s2 = ROW_LEN,   l2_s2 = 2*ROW_LEN,   reps_2 = 1;
+  uint32_t l1_s3 = 0,         l2_s3 = 0,           reps_3 = 1;
+  uint32_t len   = size;
+
+  if (shape == IDMA_2D) {
+    len    = ROW_LEN;
+    reps_2 = size / ROW_LEN;
+  } else if (shape == IDMA_3D) {
+    len    = ROW_LEN;
+    reps_2 = ROWS_PER_3;
+    l1_s3  = ROWS_PER_3*l1_s2;
+    l2_s3  = ROWS_PER_3*l2_s2;
+    reps_3 = size / (ROW_LEN*ROWS_PER_3);
+  }
+
+  if (shape == IDMA_1D)
+    l1_s2 = l2_s2 = 0;
+
+  if (dir == IDMA_DIR_L2_TO_L1)
+    return idma_mm_submit_dir(dir, 0, l1, l2, len, l1_s2, l2_s2, reps_2, l1_s3, l2_s3, reps_3);
+  else
+    return idma_mm_submit_dir(dir, 0, l2, l1, len, l2_s2, l1_s2, reps_2, l2_s3, l1_s3, reps_3);
+}
+
+// Returns 1 on timeout
+static uint32_t bench_wait(uint32_t dir, uint32_t id) {
+  uint32_t cycles = 0;
+  while (!idma_mm_id_retired_dir(dir, 0, id)) {
+    if (++cycles == TIMEOUT_CYCLES)
+      return 1;
+  }
+  return 0;
+}
+
+// Returns the cycles from the first submission to the last completion, counts the
+// timeouts of this tile in timeouts (on its own stack: .bss is shared by all tiles)
+static uint32_t bench_run(uint32_t dir, uint32_t shape, uint32_t size, uint32_t *timeouts) {
+  uint32_t hartid = get_hartid();
+  uint32_t l2     = L2_BENCH_BASE + hartid*L2_TILE_OFFSET;
+  uint32_t l1_in  = L1_IN  + hartid*L1_TILE_OFFSET;
+  uint32_t l1_out = L1_OUT + hartid*L1_TILE_OFFSET;
+  uint32_t id_a2o = 0, id_o2a = 0;
+  uint32_t start, stop;
+
+  start = get_cyclel();
+  if (dir != IDMA_DIR_L1_TO_L2)
+    id_a2o = bench_submit(IDMA_DIR_L2_TO_L1, shape, size, l1_in, l2 + L2_IN_OFFSET);
+  if (dir != IDMA_DIR_L2_TO_L1)
+    id_o2a = bench_submit(IDMA_DIR_L1_TO_L2, shape, size, l1_out, l2 + L2_OUT_OFFSET);
+  if (id_a2o)
+    *timeouts += bench_wait(IDMA_DIR_L2_TO_L1, id_a2o);
+  if (id_o2a)
+    *timeouts += bench_wait(IDMA_DIR_L1_TO_L2, id_o2a);
+  stop = get_cyclel();
+
+  return stop - start;
+}
+
+static void bench_print(const char *conf, uint32_t dir, uint32_t shape, uint32_t size,
+                        uint32_t bytes, uint32_t cycles) {
+  uint32_t bpc100 = cycles ? (bytes*100)/cycles : 0;
+  printf("%s %s %s %0d B: %0d cycles, %0d.%02d B/cycle\n",
+         conf, dir_names[dir], shape_names[shape], size, cycles, bpc100/100, bpc100%100);
+}
+
+int main(void) {
+  uint32_t hartid = get_hartid();
+  uint32_t dir_bytes;
+  uint32_t timeouts = 0;
+
+  ccount_en();
+
+  // Single tile: full sweep on tile 0, the NoC carries only its traffic
+  if (hartid == 0) {
+    printf("iDMA bandwidth, tile 0 alone\n");
+    for (uint32_t c = 0; c < NUM_CONFS; c++) {
+      bench_set_conf(&confs[c]);
+      for (uint32_t dir = 0; dir <= DIR_BOTH; dir++) {
+        dir_bytes = (dir == DIR_BOTH) ? 2 : 1;
+        for (uint32_t shape = 0; shape < NUM_SHAPES; shape++) {
+          for (uint32_t s = 0; s < NUM_SIZES; s++) {
+            if ((shape == IDMA_3D) && (sizes[s] < ROW_LEN*ROWS_PER_3))
+              continue;
+            uint32_t cycles = bench_run(dir, shape, sizes[s], &timeouts);
+            bench_print(confs[c].name, dir, shape, sizes[s], dir_bytes*sizes[s], cycles);
+          }
+        }
+      }
+    }
+    bench_set_conf(&confs[0]);
+  }
+
+  fsync_mm_global();
+
+  // All tiles at once, 1D: aggregate bytes over the slowest tile show the NoC/L2 saturation
+  if (hartid == 0)
+    printf("iDMA bandwidth, %0d tiles at once\n", NUM_HARTS);
+
+  for (uint32_t dir = 0; dir <= DIR_BOTH; dir++) {
+    dir_bytes = (dir == DIR_BOTH) ? 2 : 1;
+    for (uint32_t s = 0; s < NUM_SIZES; s++) {
+      fsync_mm_global();
+      mmio32(L1_BASE + hartid*L1_TILE_OFFSET + RESULT_OFFSET) = bench_run(dir, IDMA_1D, sizes[s], &timeouts);
+      fsync_mm_global();
+
+      if (hartid == 0) {
+        uint32_t max_cycles = 0;
+        for (uint32_t t = 0; t < NUM_HARTS; t++) {
+          uint32_t cycles = mmio32(L1_BASE + t*L1_TILE_OFFSET + RESULT_OFFSET);
+          if (cycles > max_cycles)
+            max_cycles = cycles;
+#if VERBOSE > 1
+          printf("  tile %0d: %0d cycles\n", t, cycles);
+#endif
+        }
+        bench_print("all_tiles", dir, IDMA_1D, sizes[s], NUM_HARTS*dir_bytes*sizes[s], max_cycles);
+      }
+    }
+  }
+
+  ccount_dis();
+
+  printf("Finished test with %0d timeout(s)\n", timeouts);
+
+  mmio16(TEST_END_ADDR + hartid*2) = (timeouts ? FAIL_EXIT_CODE : PASS_EXIT_CODE) - hartid;
+
+  return 0;
+}
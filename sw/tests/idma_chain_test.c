@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Descriptor Chain Test - Event Unit Version
+ * Gathers blocks of X into L1 in reverse order with one AXI2OBI chain (fence in
+ * the middle), then writes them back to L2 with one OBI2AXI chain
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+
+#define NUM_BLOCKS (6)
+#define BLOCK_LEN  (0x400)
+#define FENCE_IDX  (2)
+
+// Last block moved as 2D: rows of ROW_LEN bytes packed from the contiguous source
+#define ROW_LEN    (0x80)
+
+#define DESC_BASE  (L1_BASE + 0x00011000)
+#define IN_BASE    (L1_BASE + 0x00012000)
+#define OUT_BASE   (L2_BASE + 0x00046000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static uint32_t check_in(uint32_t blk) {
+  uint32_t src_blk = NUM_BLOCKS - 1 - blk;
+  uint32_t num_errors = 0;
+  for (int i = 0; i < BLOCK_LEN/2; i++) {
+    uint16_t computed = mmio16(IN_BASE + blk*BLOCK_LEN + 2*i);
+    uint16_t expected = x_inp[src_blk*BLOCK_LEN/2 + i];
+    if (computed != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: IN[%0d][%0d](=0x%4x) != X(=0x%4x)\n", blk, i, computed, expected);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+static uint32_t check_out(void) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < NUM_BLOCKS*BLOCK_LEN/2; i++)
+    if (mmio16(OUT_BASE + 2*i) != mmio16(IN_BASE + 2*i))
+      num_errors++;
+  return num_errors;
+}
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  idma_chain_desc_t *descs = (idma_chain_desc_t *)DESC_BASE;
+  uint32_t num_errors = 0;
+  uint32_t start, gather_cycles;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+  ccount_en();
+
+  // Gather: block i of L1 comes from block NUM_BLOCKS-1-i of X
+  for (uint32_t i = 0; i < NUM_BLOCKS - 1; i++)
+    idma_chain_desc_1d(&descs[i], IN_BASE + i*BLOCK_LEN,
+                       (uint32_t)x_inp + (NUM_BLOCKS - 1 - i)*BLOCK_LEN, BLOCK_LEN);
+  idma_chain_desc_2d(&descs[NUM_BLOCKS - 1], IN_BASE + (NUM_BLOCKS - 1)*BLOCK_LEN, (uint32_t)x_inp,
+                     ROW_LEN, ROW_LEN, ROW_LEN, BLOCK_LEN/ROW_LEN);
+  idma_chain_desc_fence(&descs[FENCE_IDX]);
+  idma_chain_link(descs, NUM_BLOCKS);
+
+  start = get_cyclel();
+  if (!idma_chain_start(IDMA_DIR_L2_TO_L1, descs))
+    num_errors++;
+
+  // The blocks up to the fence are consumed while the rest of the chain moves
+  eu_idma_wait_chain_event(IDMA_DIR_L2_TO_L1, mode);
+  for (uint32_t i = 0; i <= FENCE_IDX; i++)
+    num_errors += check_in(i);
+
+  eu_idma_wait_chain(IDMA_DIR_L2_TO_L1, mode);
+  gather_cycles = get_cyclel() - start;
+  for (uint32_t i = FENCE_IDX + 1; i < NUM_BLOCKS; i++)
+    num_errors += check_in(i);
+
+  if (!idma_mm_id_retired_dir(IDMA_DIR_L2_TO_L1, 0, idma_chain_last_id(IDMA_DIR_L2_TO_L1)))
+    num_errors++;
+
+  // Write-back: the same descriptors reused for the other direction, one job per block
+  for (uint32_t i = 0; i < NUM_BLOCKS; i++)
+    idma_chain_desc_1d(&descs[i], OUT_BASE + i*BLOCK_LEN, IN_BASE + i*BLOCK_LEN, BLOCK_LEN);
+  idma_chain_link(descs, NUM_BLOCKS);
+
+  if (!idma_chain_start(IDMA_DIR_L1_TO_L2, descs))
+    num_errors++;
+  eu_idma_wait_chain(IDMA_DIR_L1_TO_L2, mode);
+  num_errors += check_out();
+
+  // The register interface keeps working after a chain
+  dma_wait(idma_L2ToL1((uint32_t)x_inp, IN_BASE + (NUM_BLOCKS - 1)*BLOCK_LEN, BLOCK_LEN));
+  num_errors += check_in(NUM_BLOCKS - 1);
+
+  ccount_dis();
+
+  printf("Gathered %0d blocks in %0d cycles\n", NUM_BLOCKS, gather_cycles);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Completion Coalescing Test - Event Unit Version
+ * Streams X into L1 in small chunks with a descriptor chain and consumes each
+ * chunk as it lands, counting the core wake-ups with and without coalescing
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+
+#define NUM_CHUNKS (48)
+#define CHUNK_LEN  (0x100)
+
+#define COAL_K       (8)
+#define COAL_TIMEOUT (4096)
+
+#define DESC_BASE  (L1_BASE + 0x00011000)
+#define IN_BASE    (L1_BASE + 0x00014000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static uint32_t check_chunk(uint32_t c) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < CHUNK_LEN/2; i++) {
+    uint16_t computed = mmio16(IN_BASE + c*CHUNK_LEN + 2*i);
+    uint16_t expected = x_inp[c*CHUNK_LEN/2 + i];
+    if (computed != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: IN[%0d][%0d](=0x%4x) != X(=0x%4x)\n", c, i, computed, expected);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+// Returns the number of wake-ups needed to consume the whole stream
+static uint32_t run_stream(uint32_t k, uint32_t timeout, eu_wait_mode_t mode, uint32_t *num_errors) {
+  idma_chain_desc_t *descs = (idma_chain_desc_t *)DESC_BASE;
+  uint32_t first_id, wakes = 0;
+
+  for (uint32_t c = 0; c < NUM_CHUNKS; c++)
+    mmio32(IN_BASE + c*CHUNK_LEN) = 0xDEADBEEF;
+
+  eu_idma_set_coalescing(IDMA_DIR_L2_TO_L1, k, timeout);
+  eu_enable_events(EU_IDMA_A2O_DONE_MASK);
+  eu_clear_events(0xFFFFFFFF);
+
+  for (uint32_t c = 0; c < NUM_CHUNKS; c++)
+    idma_chain_desc_1d(&descs[c], IN_BASE + c*CHUNK_LEN, (uint32_t)x_inp + c*CHUNK_LEN, CHUNK_LEN);
+  idma_chain_link(descs, NUM_CHUNKS);
+
+  // The channel is idle: the chain jobs take the IDs following DONE_ID
+  first_id = idma_mm_get_done_id_dir(IDMA_DIR_L2_TO_L1, 0) + 1;
+  if (!idma_chain_start(IDMA_DIR_L2_TO_L1, descs))
+    (*num_errors)++;
+
+  for (uint32_t c = 0; c < NUM_CHUNKS; c++) {
+    while (!idma_mm_id_retired_dir(IDMA_DIR_L2_TO_L1, 0, first_id + c)) {
+      eu_wait_events(EU_IDMA_A2O_DONE_MASK, mode, 0);
+      wakes++;
+    }
+    *num_errors += check_chunk(c);
+  }
+
+  idma_chain_wait(IDMA_DIR_L2_TO_L1);
+  eu_idma_set_coalescing(IDMA_DIR_L2_TO_L1, 0, 0);
+
+  return wakes;
+}
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  uint32_t num_errors = 0;
+  uint32_t wakes_plain, wakes_coal;
+
+  eu_init();
+
+  wakes_plain = run_stream(1, 0, mode, &num_errors);
+  wakes_coal  = run_stream(COAL_K, COAL_TIMEOUT, mode, &num_errors);
+
+  printf("%0d chunks: %0d wake-ups per job, %0d with K=%0d\n", NUM_CHUNKS, wakes_plain, wakes_coal, COAL_K);
+
+  if (wakes_coal > wakes_plain)
+    num_errors++;
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
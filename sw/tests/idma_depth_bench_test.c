@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Outstanding Depth Benchmark using Memory-Mapped Control
+ * Streams back-to-back small transfers keeping at most DEPTH of them in flight
+ * and reports bytes per cycle for each transfer size and depth
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+#define L1_BUF  (L1_BASE + 0x00020000)
+#define L2_BUF  (L2_BASE + 0x00100000)
+
+#define NUM_XFERS  (16)
+#define NUM_SIZES  (7)
+#define NUM_DEPTHS (4)
+
+#define TIMEOUT_CYCLES (1000000)
+
+#define VERBOSE (0)
+
+static const uint32_t sizes[NUM_SIZES]   = {64, 128, 256, 512, 1024, 2048, 4096};
+// Depths above IDMA_MAX_OUTSTANDING stall on NEXT_ID and show the HW limit
+static const uint32_t depths[NUM_DEPTHS] = {1, 2, 4, 8};
+
+static const char *dir_names[2] = {"L2->L1", "L1->L2"};
+
+static uint32_t timeouts = 0;
+
+static void bench_wait(uint32_t dir, uint32_t id) {
+  uint32_t cycles = 0;
+  while (!idma_mm_id_retired_dir(dir, 0, id)) {
+    if (++cycles == TIMEOUT_CYCLES) {
+      timeouts++;
+      return;
+    }
+  }
+}
+
+// Returns the cycles to move NUM_XFERS consecutive chunks of size bytes
+static uint32_t bench_run(uint32_t dir, uint32_t size, uint32_t depth) {
+  uint32_t ids[NUM_XFERS];
+  uint32_t start, stop;
+
+  start = get_cyclel();
+  for (uint32_t i = 0; i < NUM_XFERS; i++) {
+    uint32_t l1 = L1_BUF + i*size;
+    uint32_t l2 = L2_BUF + i*size;
+
+    if (i >= depth)
+      bench_wait(dir, ids[i - depth]);
+
+    if (dir == IDMA_DIR_L2_TO_L1)
+      ids[i] = idma_mm_submit_dir(dir, 0, l1, l2, size, 0, 0, 1, 0, 0, 1);
+    else
+      ids[i] = idma_mm_submit_dir(dir, 0, l2, l1, size, 0, 0, 1, 0, 0, 1);
+  }
+  bench_wait(dir, ids[NUM_XFERS - 1]);
+  stop = get_cyclel();
+
+  return stop - start;
+}
+
+int main(void) {
+  ccount_en();
+
+  printf("iDMA bandwidth vs outstanding depth (HW limit %0d)\n", IDMA_MAX_OUTSTANDING);
+
+  for (uint32_t dir = 0; dir < 2; dir++) {
+    for (uint32_t s = 0; s < NUM_SIZES; s++) {
+      for (uint32_t d = 0; d < NUM_DEPTHS; d++) {
+        uint32_t cycles = bench_run(dir, sizes[s], depths[d]);
+        uint32_t bpc100 = cycles ? (NUM_XFERS*sizes[s]*100)/cycles : 0;
+        printf("%s %0d B depth %0d: %0d cycles, %0d.%02d B/cycle\n",
+               dir_names[dir], sizes[s], depths[d], cycles, bpc100/100, bpc100%100);
+      }
+    }
+  }
+
+  ccount_dis();
+
+  printf("Finished test with %0d timeout(s)\n", timeouts);
+
+  mmio16(TEST_END_ADDR) = timeouts ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
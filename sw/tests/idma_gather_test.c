@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Indexed Gather Test - Event Unit Version
+ * Looks up rows of a table in L2 (X seen as NUM_ROWS rows) by index, once with
+ * one submit per row and once with a single gather descriptor, and compares them
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+
+#define ROW_LEN    (0x80)
+#define NUM_ROWS   (6144*2/ROW_LEN)
+#define NUM_LOOKUP (32)
+
+#define DESC_BASE  (L1_BASE + 0x00011000)
+#define IDX_BASE   (L1_BASE + 0x00011100)
+#define REF_BASE   (L1_BASE + 0x00012000)
+#define OUT_BASE   (L1_BASE + 0x00014000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  idma_chain_desc_t *desc = (idma_chain_desc_t *)DESC_BASE;
+  uint32_t *idx = (uint32_t *)IDX_BASE;
+  uint32_t num_errors = 0;
+  uint32_t start, row_cycles, gather_cycles;
+  uint32_t seed = 0x1234, id = 0;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+  ccount_en();
+
+  // Row offsets, repeats allowed as in real lookups
+  for (uint32_t i = 0; i < NUM_LOOKUP; i++) {
+    seed   = seed*1103515245 + 12345;
+    idx[i] = ((seed >> 16) % NUM_ROWS) * ROW_LEN;
+  }
+  for (uint32_t i = 0; i < NUM_LOOKUP*ROW_LEN/4; i++)
+    mmio32(OUT_BASE + 4*i) = 0xDEADBEEF;
+
+  // Baseline: one submit per row
+  start = get_cyclel();
+  for (uint32_t i = 0; i < NUM_LOOKUP; i++)
+    id = idma_L2ToL1((uint32_t)x_inp + idx[i], REF_BASE + i*ROW_LEN, ROW_LEN);
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+  row_cycles = get_cyclel() - start;
+
+  // Gather: one descriptor, one event
+  start = get_cyclel();
+  if (!idma_gather_L2ToL1(desc, OUT_BASE, (uint32_t)x_inp, ROW_LEN, idx, NUM_LOOKUP))
+    num_errors++;
+  eu_idma_wait_chain(IDMA_DIR_L2_TO_L1, mode);
+  gather_cycles = get_cyclel() - start;
+
+  ccount_dis();
+
+  for (uint32_t i = 0; i < NUM_LOOKUP; i++) {
+    for (uint32_t j = 0; j < ROW_LEN/2; j++) {
+      uint16_t computed = mmio16(OUT_BASE + i*ROW_LEN + 2*j);
+      uint16_t expected = x_inp[idx[i]/2 + j];
+      if (computed != expected || mmio16(REF_BASE + i*ROW_LEN + 2*j) != expected) {
+        num_errors++;
+#if VERBOSE > 10
+        printf("**ERROR**: OUT[%0d][%0d](=0x%4x) != X(=0x%4x)\n", i, j, computed, expected);
+#endif
+      }
+    }
+  }
+
+  printf("%0d rows of %0d B: %0d cycles with one submit per row, %0d with a gather\n",
+         NUM_LOOKUP, ROW_LEN, row_cycles, gather_cycles);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Large Transfer Test using Memory-Mapped Control
+ * Moves a buffer larger than 64 KiB L2 -> L1 -> L2 with the 32-bit length API
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+#define SRC_BASE (L2_BASE + 0x00100000)
+#define L1_BUF   (L1_BASE + 0x00010000)
+#define DST_BASE (L2_BASE + 0x00200000)
+
+// Two full 64 KiB rows plus a misaligned tail
+#define LEN (2*IDMA_LARGE_ROW_LEN + 0x126)
+
+#define VERBOSE (0)
+
+#define PATTERN(i) ((uint16_t)(0x5A00 ^ (i)))
+
+int main(void) {
+  uint32_t num_errors = 0;
+  uint32_t transfer_id;
+
+  for (int i = 0; i < LEN/2; i++)
+    mmio16(SRC_BASE + 2*i) = PATTERN(i);
+
+  printf("Moving %0d bytes L2 -> L1...\n", LEN);
+  transfer_id = idma_L2ToL1_large(SRC_BASE, L1_BUF, LEN);
+  dma_wait(transfer_id);
+
+  printf("Moving %0d bytes L1 -> L2...\n", LEN);
+  transfer_id = idma_L1ToL2_large(L1_BUF, DST_BASE, LEN);
+  dma_wait(transfer_id);
+
+  for (int i = 0; i < LEN/2; i++) {
+    if (mmio16(DST_BASE + 2*i) != PATTERN(i)) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("DST[0x%0x]: 0x%0x != 0x%0x\n", DST_BASE + 2*i, mmio16(DST_BASE + 2*i), PATTERN(i));
+#endif
+    }
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Multicast DMA Test
+ * Delivers the W block to every tile, first with one L2 read per tile and then
+ * with one L2 read and the multicast tree, and reports the cycles of both
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+#include "idma_mcast_utils.h"
+#include "event_unit_utils.h"
+#include "fsync_mm_utils.h"
+#include "fsync_mm_api.h"
+
+#include "w_input.h"
+
+#define W_LEN (4096*2)
+
+// Offsets from L1_BASE, valid on every tile
+#define W_OFFSET      (0x00012000)
+#define RESULT_OFFSET (0x00010000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static uint32_t check_w(void) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < W_LEN/2; i++) {
+    uint16_t computed = mmio16(idma_local_l1_addr(W_OFFSET) + 2*i);
+    if (computed != w_inp[i]) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("W[%0d](=0x%4x) != 0x%4x\n", i, computed, w_inp[i]);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+static void clear_w(void) {
+  for (int i = 0; i < W_LEN/4; i++)
+    mmio32(idma_local_l1_addr(W_OFFSET) + 4*i) = 0;
+}
+
+// Slowest tile, collected by tile 0 from the L1 of every tile
+static uint32_t max_cycles(void) {
+  uint32_t max = 0;
+  for (uint32_t t = 0; t < NUM_HARTS; t++) {
+    uint32_t cycles = mmio32(idma_tile_l1_addr(t, RESULT_OFFSET));
+    if (cycles > max)
+      max = cycles;
+  }
+  return max;
+}
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  uint32_t hartid = get_hartid();
+  uint32_t start;
+  uint32_t per_tile_cycles = 0, mcast_cycles;
+  uint32_t num_errors = 0;
+  uint32_t exit_code;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+  idma_notify_init();
+  ccount_en();
+
+  // Baseline: every tile reads W from L2
+  clear_w();
+  fsync_mm_global();
+  start = get_cyclel();
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0,
+                              idma_L2ToL1_large((uint32_t)w_inp, idma_local_l1_addr(W_OFFSET), W_LEN));
+  mmio32(idma_local_l1_addr(RESULT_OFFSET)) = get_cyclel() - start;
+  num_errors += check_w();
+  fsync_mm_global();
+  if (hartid == 0)
+    per_tile_cycles = max_cycles();
+
+  // Multicast: tile 0 reads W from L2, the tree forwards it
+  clear_w();
+  fsync_mm_global();
+  start = get_cyclel();
+  idma_mcast_from_l2(0, NUM_HARTS, W_OFFSET, (uint32_t)w_inp, W_LEN, mode);
+  mmio32(idma_local_l1_addr(RESULT_OFFSET)) = get_cyclel() - start;
+  num_errors += check_w();
+  fsync_mm_global();
+
+  ccount_dis();
+
+  if (hartid == 0) {
+    uint32_t rounds = 0;
+    while ((1u << rounds) < NUM_HARTS)
+      rounds++;
+    mcast_cycles = max_cycles();
+    printf("%0dx%0d mesh, %0d B to every tile, %0d tree rounds\n", MESH_X_TILES, MESH_Y_TILES, W_LEN, rounds);
+    printf("One L2 read per tile: %0d cycles, %0d B from L2\n", per_tile_cycles, NUM_HARTS*W_LEN);
+    printf("Multicast tree:       %0d cycles, %0d B from L2\n", mcast_cycles, W_LEN);
+    printf("Speedup: %0d.%02dx\n", per_tile_cycles/mcast_cycles, ((per_tile_cycles%mcast_cycles)*100)/mcast_cycles);
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  exit_code = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+  mmio16(TEST_END_ADDR + hartid*2) = exit_code - hartid;
+
+  return 0;
+}
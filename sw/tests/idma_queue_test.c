@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Independent Streams Test using Memory-Mapped Control
+ * A prefetch stream (L2 -> L1) and a write-back stream (L1 -> L2) run concurrently,
+ * each one waited on through its own completion tracking
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+#include "x_input.h"
+
+#define PREFETCH_BUF  (L1_BASE + 0x00012048)
+#define WRITEBACK_BUF (L1_BASE + 0x00016048)
+#define WRITEBACK_DST (L2_BASE + 0x00046000)
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+
+#define LEN (M_SIZE*N_SIZE*2)
+
+#define VERBOSE (0)
+
+int main(void) {
+  idma_queue_t prefetch, writeback;
+  uint32_t num_errors = 0;
+
+  if (idma_queue_init(&prefetch,  IDMA_DIR_L2_TO_L1, 0) != IDMA_QUEUE_OK)
+    num_errors++;
+  if (idma_queue_init(&writeback, IDMA_DIR_L1_TO_L2, 0) != IDMA_QUEUE_OK)
+    num_errors++;
+  // Streams the iDMA does not implement are refused, not mapped to stream 0
+  if (idma_queue_init(&writeback, IDMA_DIR_L1_TO_L2, IDMA_NUM_STREAMS) != IDMA_QUEUE_BAD_STREAM)
+    num_errors++;
+
+  // Data produced by the core, to be written back
+  for (int i = 0; i < M_SIZE*N_SIZE; i++)
+    mmio16(WRITEBACK_BUF + 2*i) = (uint16_t)~x_inp[i];
+
+  // Both directions are in flight at the same time
+  idma_queue_memcpy(&writeback, WRITEBACK_BUF, WRITEBACK_DST, LEN);
+  idma_queue_memcpy(&prefetch, (uint32_t)x_inp, PREFETCH_BUF, LEN);
+
+  // Only the prefetch is needed to go on
+  idma_queue_wait(&prefetch);
+  printf("Prefetch done, write-back %s...\n", idma_queue_is_done(&writeback) ? "done" : "in flight");
+
+  for (int i = 0; i < M_SIZE*N_SIZE; i++) {
+    if (mmio16(PREFETCH_BUF + 2*i) != x_inp[i]) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("PREFETCH[%0d]: 0x%0x != 0x%0x\n", i, mmio16(PREFETCH_BUF + 2*i), x_inp[i]);
+#endif
+    }
+  }
+
+  idma_queue_wait(&writeback);
+
+  for (int i = 0; i < M_SIZE*N_SIZE; i++) {
+    uint16_t expected = ~x_inp[i];
+    if (mmio16(WRITEBACK_DST + 2*i) != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("WRITEBACK[%0d]: 0x%0x != 0x%0x\n", i, mmio16(WRITEBACK_DST + 2*i), expected);
+#endif
+    }
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
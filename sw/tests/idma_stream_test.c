@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Streaming Pipeline Test - Event Unit Version
+ * Streams x_inp through L1 in tiles with triple buffering: prefetch (AXI2OBI),
+ * core kernel and write-back (OBI2AXI) overlap
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_stream_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+
+#define NUM_TILES  (8)
+#define TILE_ELEMS ((M_SIZE*N_SIZE)/NUM_TILES)
+#define TILE_LEN   (TILE_ELEMS*2)
+
+#define NUM_BUFS (3)
+
+#define IN_BASE  (L1_BASE + 0x00012048)
+#define OUT_BASE (L1_BASE + 0x00016048)
+#define DST_BASE (L2_BASE + 0x00046000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static void negate_kernel(uint32_t tile_idx, uint32_t in_buf, uint32_t out_buf, void *args) {
+  for (int i = 0; i < TILE_ELEMS; i++)
+    mmio16(out_buf + 2*i) = (uint16_t)~mmio16(in_buf + 2*i);
+#if VERBOSE > 1
+  printf("Tile %0d computed...\n", tile_idx);
+#endif
+}
+
+int main(void) {
+  idma_stream_t stream;
+  uint32_t in_bufs[NUM_BUFS];
+  uint32_t out_bufs[NUM_BUFS];
+  uint32_t num_errors = 0;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+
+  for (int b = 0; b < NUM_BUFS; b++) {
+    in_bufs[b]  = IN_BASE  + b*TILE_LEN;
+    out_bufs[b] = OUT_BASE + b*TILE_LEN;
+  }
+
+  idma_stream_init(&stream, NUM_BUFS, in_bufs, TILE_LEN, out_bufs, TILE_LEN,
+                   USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING);
+
+  idma_stream_run(&stream, (uint32_t)x_inp, TILE_LEN, DST_BASE, TILE_LEN,
+                  NUM_TILES, negate_kernel, 0);
+
+  for (int i = 0; i < M_SIZE*N_SIZE; i++) {
+    uint16_t expected = ~x_inp[i];
+    if (mmio16(DST_BASE + 2*i) != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("DST[%0d]: 0x%0x != 0x%0x\n", i, mmio16(DST_BASE + 2*i), expected);
+#endif
+    }
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
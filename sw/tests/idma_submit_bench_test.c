@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Submission Cost Benchmark using Memory-Mapped Control
+ * Measures the core cycles spent per submitted job with every register
+ * rewritten, with the shadow registers and with batch submission
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+#include "x_input.h"
+
+#define NUM_JOBS (32)
+#define JOB_LEN  (64)
+
+#define L1_BUF (L1_BASE + 0x00012048)
+
+#define VERBOSE (0)
+
+static uint32_t check(void) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < NUM_JOBS*JOB_LEN/2; i++)
+    if (mmio16(L1_BUF + 2*i) != x_inp[i])
+      num_errors++;
+  return num_errors;
+}
+
+static void clear(void) {
+  for (int i = 0; i < NUM_JOBS*JOB_LEN/4; i++)
+    mmio32(L1_BUF + 4*i) = 0;
+}
+
+int main(void) {
+  uint32_t src = (uint32_t)x_inp;
+  uint32_t start, cycles_full, cycles_shadow, cycles_batch;
+  uint32_t id = 0;
+  uint32_t num_errors = 0;
+  idma_desc_t descs[NUM_JOBS];
+  idma_shape_t shape = {JOB_LEN, 0, 0, 1, 0, 0, 1};
+
+  for (int i = 0; i < NUM_JOBS; i++) {
+    descs[i].src = src + i*JOB_LEN;
+    descs[i].dst = L1_BUF + i*JOB_LEN;
+  }
+
+  ccount_en();
+
+  // Baseline: every field is written for every job
+  clear();
+  start = get_cyclel();
+  for (int i = 0; i < NUM_JOBS; i++) {
+    idma_mm_shadow_invalidate(IDMA_DIR_L2_TO_L1);
+    id = idma_L2ToL1(descs[i].src, descs[i].dst, JOB_LEN);
+  }
+  cycles_full = get_cyclel() - start;
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+  num_errors += check();
+
+  // Shadow registers: only the changed addresses are written
+  clear();
+  start = get_cyclel();
+  for (int i = 0; i < NUM_JOBS; i++)
+    id = idma_L2ToL1(descs[i].src, descs[i].dst, JOB_LEN);
+  cycles_shadow = get_cyclel() - start;
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+  num_errors += check();
+
+  // Batch submission of the same shape
+  clear();
+  start = get_cyclel();
+  id = idma_mm_submit_batch_dir(IDMA_DIR_L2_TO_L1, 0, &shape, descs, NUM_JOBS);
+  cycles_batch = get_cyclel() - start;
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+  num_errors += check();
+
+  ccount_dis();
+
+  printf("Submit cost (cycles/job): full %0d, shadow %0d, batch %0d\n",
+         cycles_full/NUM_JOBS, cycles_shadow/NUM_JOBS, cycles_batch/NUM_JOBS);
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
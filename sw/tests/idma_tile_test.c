@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Matrix Tiling Test using Memory-Mapped Control
+ * Extracts a padded and a transposed sub-block of x_inp (96x64 FP16) into L1
+ * and writes a block back into a larger L2 matrix
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_tile_utils.h"
+
+#include "x_input.h"
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+
+#define ROW  (10)
+#define COL  (5)
+#define ROWS (20)
+#define COLS (30)
+
+#define PROWS (idma_tile_round_up(ROWS, 8))
+#define PCOLS (idma_tile_round_up(COLS, REDMULE_ELEMS_PER_ACCESS))
+
+#define TILE_BASE  (L1_BASE + 0x00012048)
+#define TRANS_BASE (L1_BASE + 0x00016048)
+#define OUT_BASE   (L2_BASE + 0x00046000)
+
+#define VERBOSE (0)
+
+int main(void) {
+  idma_matrix_t x     = {(uint32_t)x_inp, N_SIZE, 2};
+  idma_matrix_t tile  = {TILE_BASE, PCOLS, 2};
+  idma_matrix_t trans = {TRANS_BASE, ROWS, 2};
+  idma_matrix_t out   = {OUT_BASE, N_SIZE, 2};
+  uint32_t num_errors = 0;
+  uint32_t id;
+
+  // Dirty the L1 tile to check that padding really writes zeros
+  for (uint32_t i = 0; i < PROWS*PCOLS; i++)
+    mmio16(TILE_BASE + 2*i) = 0xDEAD;
+
+  id = idma_tile_get_padded(&x, ROW, COL, ROWS, COLS, &tile, 8, REDMULE_ELEMS_PER_ACCESS);
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+
+  for (uint32_t r = 0; r < PROWS; r++) {
+    for (uint32_t c = 0; c < PCOLS; c++) {
+      uint16_t expected = (r < ROWS && c < COLS) ? x_inp[(ROW + r)*N_SIZE + COL + c] : 0;
+      if (mmio16(TILE_BASE + 2*(r*PCOLS + c)) != expected) {
+        num_errors++;
+#if VERBOSE > 10
+        printf("TILE[%0d][%0d]: 0x%0x != 0x%0x\n", r, c, mmio16(TILE_BASE + 2*(r*PCOLS + c)), expected);
+#endif
+      }
+    }
+  }
+
+  id = idma_tile_get_transposed(&x, ROW, COL, ROWS, COLS, &trans);
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+
+  for (int c = 0; c < COLS; c++) {
+    for (int r = 0; r < ROWS; r++) {
+      if (mmio16(TRANS_BASE + 2*(c*ROWS + r)) != x_inp[(ROW + r)*N_SIZE + COL + c]) {
+        num_errors++;
+#if VERBOSE > 10
+        printf("TRANS[%0d][%0d]: 0x%0x != 0x%0x\n", c, r, mmio16(TRANS_BASE + 2*(c*ROWS + r)), x_inp[(ROW + r)*N_SIZE + COL + c]);
+#endif
+      }
+    }
+  }
+
+  // Write the (unpadded) block back at the same position of a zeroed copy of X
+  for (int i = 0; i < M_SIZE*N_SIZE; i++)
+    mmio16(OUT_BASE + 2*i) = 0;
+
+  id = idma_tile_put(&tile, &out, ROW, COL, ROWS, COLS);
+  idma_mm_wait_for_completion(IDMA_DIR_L1_TO_L2, 0, id);
+
+  for (int r = 0; r < M_SIZE; r++) {
+    for (int c = 0; c < N_SIZE; c++) {
+      int inside = (r >= ROW) && (r < ROW + ROWS) && (c >= COL) && (c < COL + COLS);
+      uint16_t expected = inside ? x_inp[r*N_SIZE + c] : 0;
+      if (mmio16(OUT_BASE + 2*(r*N_SIZE + c)) != expected)
+        num_errors++;
+    }
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Transfer ID Wait Test - Event Unit Version
+ * Queues several jobs per direction and sleeps until a given one has retired,
+ * while later jobs of the same direction are still in flight
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+
+#define NUM_JOBS (4)
+#define JOB_LEN  (0x800)
+
+#define IN_BASE  (L1_BASE + 0x00012048)
+#define OUT_SRC  (L1_BASE + 0x00016048)
+#define OUT_BASE (L2_BASE + 0x00046000)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static uint32_t check_in(uint32_t job) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < JOB_LEN/2; i++)
+    if (mmio16(IN_BASE + job*JOB_LEN + 2*i) != x_inp[job*JOB_LEN/2 + i])
+      num_errors++;
+  return num_errors;
+}
+
+static uint32_t check_out(uint32_t job) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < JOB_LEN/2; i++)
+    if (mmio16(OUT_BASE + job*JOB_LEN + 2*i) != mmio16(OUT_SRC + job*JOB_LEN + 2*i))
+      num_errors++;
+  return num_errors;
+}
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  uint32_t in_ids[NUM_JOBS], out_ids[NUM_JOBS];
+  uint32_t num_errors = 0;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+
+  for (int i = 0; i < NUM_JOBS*JOB_LEN/2; i++)
+    mmio16(OUT_SRC + 2*i) = (uint16_t)(i ^ 0x5A5A);
+
+  for (int j = 0; j < NUM_JOBS; j++) {
+    in_ids[j]  = idma_L2ToL1((uint32_t)x_inp + j*JOB_LEN, IN_BASE + j*JOB_LEN, JOB_LEN);
+    out_ids[j] = idma_L1ToL2(OUT_SRC + j*JOB_LEN, OUT_BASE + j*JOB_LEN, JOB_LEN);
+  }
+
+  // Each job is consumed as soon as it retires, the next ones keep moving
+  for (int j = 0; j < NUM_JOBS; j++) {
+    eu_idma_wait_id(IDMA_DIR_L2_TO_L1, 0, in_ids[j], mode);
+    num_errors += check_in(j);
+#if VERBOSE > 1
+    printf("Job %0d (ID %0d) in, last in ID retired: %0d\n", j, in_ids[j],
+           idma_mm_id_retired_dir(IDMA_DIR_L2_TO_L1, 0, in_ids[NUM_JOBS-1]));
+#endif
+  }
+
+  // Waiting on an already retired ID returns without sleeping
+  eu_idma_wait_id(IDMA_DIR_L2_TO_L1, 0, in_ids[0], mode);
+
+  eu_idma_wait_id(IDMA_DIR_L1_TO_L2, 0, out_ids[NUM_JOBS-1], mode);
+  for (int j = 0; j < NUM_JOBS; j++)
+    num_errors += check_out(j);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
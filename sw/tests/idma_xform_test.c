@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA L1 Data Transform Test using Memory-Mapped Control
+ * Fills L1 with the iDMA and converts FP32 data to FP16/FP8 on the way into L1
+ * and back to FP32 on the way out, against a SW reference
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+#include "x_input.h"
+
+#define NUM_ELEMS (1024)
+
+#define FILL_LEN  (0x1100)  // Rows and a tail
+#define FILL_BASE (L1_BASE + 0x00012000)
+#define F16_BASE  (L1_BASE + 0x00016000)
+#define F8_BASE   (L1_BASE + 0x00018000)
+
+#define VERBOSE (0)
+
+// FP32 data in L2
+static uint32_t f32_in[NUM_ELEMS];
+static uint32_t f32_out[NUM_ELEMS];
+
+//=============================================================================
+// SW reference (round to nearest even, saturation to infinity, flush to zero)
+//=============================================================================
+
+static uint32_t ref_fp16_to_fp32(uint16_t h) {
+  uint32_t s = (uint32_t)(h >> 15) << 31, e = (h >> 10) & 0x1F, m = h & 0x3FF;
+  if (e == 0x1F) return s | 0x7F800000 | (m << 13);
+  if (e == 0)    return s;
+  return s | ((e + 112) << 23) | (m << 13);
+}
+
+static uint32_t ref_fp32_narrow(uint32_t f, uint32_t mant_bits) {
+  uint32_t s = f >> 31, e = (f >> 23) & 0xFF, m = f & 0x7FFFFF;
+  uint32_t width = 1 + 5 + mant_bits;
+  uint32_t drop = 23 - mant_bits;
+  int32_t  exp = (int32_t)e - 127 + 15;
+  uint32_t res;
+
+  if (e == 0xFF)
+    return (s << (width - 1)) | (0x1F << mant_bits) | (m ? (1 << (mant_bits - 1)) : 0);
+  if (exp >= 31)
+    return (s << (width - 1)) | (0x1F << mant_bits);
+  if (exp <= 0)
+    return s << (width - 1);
+
+  res = ((uint32_t)exp << mant_bits) | (m >> drop);
+  if (((m >> (drop - 1)) & 1) && ((m & ((1 << (drop - 1)) - 1)) || (res & 1)))
+    res++;
+  return (s << (width - 1)) | res;
+}
+
+//=============================================================================
+
+static uint32_t check_fill(uint32_t pattern) {
+  uint32_t num_errors = 0;
+  for (int i = 0; i < FILL_LEN/4; i++)
+    if (mmio32(FILL_BASE + 4*i) != pattern)
+      num_errors++;
+  // The word after the buffer is untouched
+  if (mmio32(FILL_BASE + FILL_LEN) != 0x12345678)
+    num_errors++;
+  return num_errors;
+}
+
+int main(void) {
+  uint32_t num_errors = 0;
+
+  // Memset
+  mmio32(FILL_BASE + FILL_LEN) = 0x12345678;
+  idma_memset_l1(FILL_BASE, 0, FILL_LEN);
+  num_errors += check_fill(0);
+  idma_memset_l1(FILL_BASE, 0xA5A5A5A5, FILL_LEN);
+  num_errors += check_fill(0xA5A5A5A5);
+
+  for (int i = 0; i < NUM_ELEMS; i++)
+    f32_in[i] = ref_fp16_to_fp32(x_inp[i]);
+
+  // FP32 -> FP16 into L1
+  idma_L2ToL1_fp32_narrow((uint32_t)f32_in, F16_BASE, NUM_ELEMS, IDMA_XFORM_FP32_FP16);
+  for (int i = 0; i < NUM_ELEMS; i++) {
+    uint16_t computed = mmio16(F16_BASE + 2*i);
+    uint16_t expected = (uint16_t)ref_fp32_narrow(f32_in[i], 10);
+    if (computed != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("FP16[%0d](=0x%4x) != 0x%4x\n", i, computed, expected);
+#endif
+    }
+  }
+
+  // FP32 -> FP8 into L1
+  idma_L2ToL1_fp32_narrow((uint32_t)f32_in, F8_BASE, NUM_ELEMS, IDMA_XFORM_FP32_FP8);
+  for (int i = 0; i < NUM_ELEMS; i++) {
+    uint8_t computed = mmio8(F8_BASE + i);
+    uint8_t expected = (uint8_t)ref_fp32_narrow(f32_in[i], 2);
+    if (computed != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("FP8[%0d](=0x%2x) != 0x%2x\n", i, computed, expected);
+#endif
+    }
+  }
+
+  // FP16 in L1 -> FP32 into L2
+  idma_L1ToL2_fp32_widen(F16_BASE, (uint32_t)f32_out, NUM_ELEMS, IDMA_XFORM_FP16_FP32);
+  for (int i = 0; i < NUM_ELEMS; i++) {
+    uint32_t expected = ref_fp16_to_fp32(mmio16(F16_BASE + 2*i));
+    if (f32_out[i] != expected) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("FP32[%0d](=0x%8x) != 0x%8x\n", i, f32_out[i], expected);
+#endif
+    }
+  }
+
+  // Plain transfers are back to normal
+  dma_wait(idma_L2ToL1((uint32_t)x_inp, F16_BASE, NUM_ELEMS*2));
+  for (int i = 0; i < NUM_ELEMS; i++)
+    if (mmio16(F16_BASE + 2*i) != x_inp[i])
+      num_errors++;
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
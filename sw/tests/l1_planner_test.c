@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA L1 Bank Conflict Microbenchmark using Memory-Mapped Control
+ * Runs a RedMulE GEMM while both iDMA channels stream through L1, with all the
+ * buffers starting on bank 0 and with the placement of the L1 planner
+ */
+
+#include "magia_tile_utils.h"
+#include "redmule_mm_utils.h"
+#include "idma_mm_utils.h"
+#include "l1_planner_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+#define K_SIZE (64)
+
+#define DMA_LEN  (M_SIZE*N_SIZE*2)
+#define DMA_DST  (L2_BASE + 0x00046000)
+
+#define NAIVE_STRIDE (0x00004000) // Multiple of L1_ROW_BYTES: every buffer starts on bank 0
+
+#define DIFF_TH (0x0011)
+
+#define VERBOSE (0)
+
+enum { BUF_X = 0, BUF_W, BUF_Y, BUF_DMA_IN, BUF_DMA_OUT, NUM_BUFS };
+
+static uint32_t run_gemm(const l1_buf_t *bufs, uint32_t *num_errors) {
+  uint32_t x = bufs[BUF_X].addr, w = bufs[BUF_W].addr, y = bufs[BUF_Y].addr;
+  uint32_t id_in, id_out;
+  uint32_t start, cycles;
+  uint16_t computed, expected, diff;
+
+  dma_wait(idma_data_to_l1(x_inp, x, M_SIZE*N_SIZE*2));
+  dma_wait(idma_data_to_l1(w_inp, w, N_SIZE*K_SIZE*2));
+  dma_wait(idma_data_to_l1(y_inp, y, M_SIZE*K_SIZE*2));
+
+  hwpe_soft_clear();
+  while (hwpe_acquire_job() < 0)
+    ;
+  redmule_cfg(x, w, y, M_SIZE, N_SIZE, K_SIZE, (uint8_t)gemm_ops, (uint8_t)Float16);
+
+  // Both iDMA channels stream through L1 for the whole GEMM
+  start  = get_cyclel();
+  id_in  = idma_L2ToL1((uint32_t)x_inp, bufs[BUF_DMA_IN].addr, DMA_LEN);
+  id_out = idma_L1ToL2(bufs[BUF_DMA_OUT].addr, DMA_DST, DMA_LEN);
+  hwpe_trigger_job();
+  hwpe_wait_for_completion();
+  cycles = get_cyclel() - start;
+
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id_in);
+  idma_mm_wait_for_completion(IDMA_DIR_L1_TO_L2, 0, id_out);
+
+  for (int i = 0; i < M_SIZE*K_SIZE; i++) {
+    computed = mmio16(y + 2*i);
+    expected = z_oup[i];
+    diff = (computed > expected) ? (computed - expected) : (expected - computed);
+    if (diff > DIFF_TH) {
+      (*num_errors)++;
+#if VERBOSE > 10
+      printf("**ERROR**: Y[%8x](=0x%4x) != Z[%0d](=0x%4x)\n", y + 2*i, computed, i, expected);
+#endif
+    }
+  }
+
+  return cycles;
+}
+
+int main(void) {
+  // All live during the timed GEMM
+  l1_buf_t bufs[NUM_BUFS] = {
+    {"X",       M_SIZE*N_SIZE*2, L1_ACCESS_HWPE, L1_PHASE(0), 0},
+    {"W",       N_SIZE*K_SIZE*2, L1_ACCESS_HWPE, L1_PHASE(0), 0},
+    {"Y",       M_SIZE*K_SIZE*2, L1_ACCESS_HWPE, L1_PHASE(0), 0},
+    {"DMA_IN",  DMA_LEN,         L1_ACCESS_DMA,  L1_PHASE(0), 0},
+    {"DMA_OUT", DMA_LEN,         L1_ACCESS_DMA,  L1_PHASE(0), 0},
+  };
+  // Used one after the other: no padding between them, no conflict counted
+  l1_buf_t seq[2] = {
+    {"PRE",  L1_ROW_BYTES, L1_ACCESS_HWPE, L1_PHASE(0), 0},
+    {"POST", L1_ROW_BYTES, L1_ACCESS_HWPE, L1_PHASE(1), 0},
+  };
+  uint32_t naive_cycles, naive_conflicts;
+  uint32_t plan_cycles, plan_conflicts;
+  uint32_t num_errors = 0;
+
+  hwpe_cg_enable();
+  ccount_en();
+
+  // Hand placement on bank row boundaries
+  for (int i = 0; i < NUM_BUFS; i++)
+    bufs[i].addr = L1_BASE + 0x00010000 + i*NAIVE_STRIDE;
+  naive_conflicts = l1_plan_conflicts(bufs, NUM_BUFS);
+  naive_cycles    = run_gemm(bufs, &num_errors);
+
+  if (!l1_plan(bufs, NUM_BUFS, L1_BASE + 0x00010000, L1_BASE + L1_SIZE)) {
+    printf("Buffers do not fit in L1\n");
+    num_errors++;
+  }
+#if VERBOSE > 1
+  l1_plan_print(bufs, NUM_BUFS);
+#endif
+  plan_conflicts = l1_plan_conflicts(bufs, NUM_BUFS);
+  plan_cycles    = run_gemm(bufs, &num_errors);
+
+  ccount_dis();
+
+  printf("Bank-aligned: %0d shared banks, %0d cycles\n", naive_conflicts, naive_cycles);
+  printf("Planned:      %0d shared banks, %0d cycles\n", plan_conflicts, plan_cycles);
+
+  if (plan_conflicts > naive_conflicts)
+    num_errors++;
+
+  if (!l1_plan(seq, 2, L1_BASE + 0x00010000, L1_BASE + L1_SIZE) ||
+      (seq[1].addr != seq[0].addr + L1_ROW_BYTES) || l1_plan_conflicts(seq, 2))
+    num_errors++;
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Batched GEMM Test
+ * Splits the reference GEMM in heads of HEAD_M rows sharing W, runs them as single
+ * magia_gemm calls, as a strided batch and as a batch of pointers, and reports the
+ * cycles per GEMM of each
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_gemm_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+#define K_SIZE (64)
+
+#define HEAD_M    (24)
+#define NUM_HEADS (M_SIZE/HEAD_M)
+#define BATCH     (2*NUM_HEADS)   // Pointer batch: every head twice
+
+#define X_STRIDE  (HEAD_M*N_SIZE*2)
+#define YZ_STRIDE (HEAD_M*K_SIZE*2)
+
+#define DIFF_TH (0x0011)
+
+#define VERBOSE (0)
+
+// Results in L2 (.bss)
+static uint16_t z_buf[M_SIZE*K_SIZE];
+static uint16_t z2_buf[M_SIZE*K_SIZE];
+
+static magia_gemm_ptrs_t ops[BATCH];
+
+static void clear_z(uint32_t z) {
+  for (int i = 0; i < M_SIZE*K_SIZE; i++)
+    mmio16(z + 2*i) = 0;
+}
+
+static uint32_t check_z(uint32_t z) {
+  uint32_t num_errors = 0;
+  uint16_t computed, expected, diff;
+  for (int i = 0; i < M_SIZE*K_SIZE; i++) {
+    computed = mmio16(z + 2*i);
+    expected = z_oup[i];
+    diff = (computed > expected) ? (computed - expected) : (expected - computed);
+    if (diff > DIFF_TH) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: Z[%0d](=0x%4x) != 0x%4x\n", i, computed, expected);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+int main(void) {
+  uint32_t num_errors = 0;
+  uint32_t start, single, strided, pointers;
+
+  ccount_en();
+
+  // Single calls
+  start = get_cyclel();
+  for (int h = 0; h < NUM_HEADS; h++)
+    if (magia_gemm((uint32_t)x_inp + h*X_STRIDE, (uint32_t)w_inp, (uint32_t)y_inp + h*YZ_STRIDE,
+                   (uint32_t)z_buf + h*YZ_STRIDE, HEAD_M, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+      num_errors++;
+  single = get_cyclel() - start;
+  num_errors += check_z((uint32_t)z_buf);
+
+  // Strided batch, W shared
+  clear_z((uint32_t)z_buf);
+  start = get_cyclel();
+  if (magia_gemm_batched_strided((uint32_t)x_inp, X_STRIDE, (uint32_t)w_inp, 0,
+                                 (uint32_t)y_inp, YZ_STRIDE, (uint32_t)z_buf, YZ_STRIDE,
+                                 NUM_HEADS, HEAD_M, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+    num_errors++;
+  strided = get_cyclel() - start;
+  num_errors += check_z((uint32_t)z_buf);
+
+  // Pointer batch: the heads in reverse order into z2_buf, then again into z_buf
+  clear_z((uint32_t)z_buf);
+  for (int i = 0; i < BATCH; i++) {
+    int h = NUM_HEADS - 1 - (i % NUM_HEADS);
+    ops[i].x = (uint32_t)x_inp + h*X_STRIDE;
+    ops[i].w = (uint32_t)w_inp;
+    ops[i].y = (uint32_t)y_inp + h*YZ_STRIDE;
+    ops[i].z = ((i < NUM_HEADS) ? (uint32_t)z2_buf : (uint32_t)z_buf) + h*YZ_STRIDE;
+  }
+  start = get_cyclel();
+  if (magia_gemm_batched(ops, BATCH, HEAD_M, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+    num_errors++;
+  pointers = get_cyclel() - start;
+  num_errors += check_z((uint32_t)z2_buf);
+  num_errors += check_z((uint32_t)z_buf);
+
+  ccount_dis();
+
+  printf("%0d heads of %0dx%0dx%0d, cycles per GEMM:\n", NUM_HEADS, HEAD_M, N_SIZE, K_SIZE);
+  printf("  single calls:  %0d\n", single/NUM_HEADS);
+  printf("  strided batch: %0d\n", strided/NUM_HEADS);
+  printf("  pointer batch: %0d\n", pointers/BATCH);
+  printf("  overhead saved per GEMM: %0d\n", (single - strided)/NUM_HEADS);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
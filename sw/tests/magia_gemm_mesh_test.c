@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Distributed GEMM Test and Scaling Benchmark
+ * Builds in L2 one GEMM made of a MESH_Y_TILES x MESH_X_TILES grid of reference
+ * 96x64x64 blocks, times one block on tile 0 alone and then the whole GEMM on the
+ * mesh, and reports the achieved throughput against NUM_HARTS times the single tile.
+ * Build with 2x2, 4x4 and 8x8 meshes (see "Changing number of tiles") for the scaling.
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+#include "magia_gemm_mesh_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+#define BLK_M (96)
+#define BLK_K (64)
+
+#define M_SIZE (MESH_Y_TILES*BLK_M)
+#define N_SIZE (64)
+#define K_SIZE (MESH_X_TILES*BLK_K)
+
+// Global matrices in L2, sized for up to 8x8 tiles
+#define X_G (L2_BASE + 0x00100000)
+#define W_G (L2_BASE + 0x00140000)
+#define Y_G (L2_BASE + 0x00180000)
+#define Z_G (L2_BASE + 0x00280000)
+
+#define STAGE_OFFSET (0x00012000)
+
+#define DIFF_TH (0x0011)
+
+#define VERBOSE (0)
+
+// Copies the rows x cols reference block at src into the global matrix mat, through L1
+static void place_block(uint32_t mat, uint32_t ld, uint32_t row, uint32_t col,
+                        const uint16_t *src, uint32_t rows, uint32_t cols) {
+  uint32_t stage = idma_local_l1_addr(STAGE_OFFSET);
+
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, idma_L2ToL1_large((uint32_t)src, stage, rows*cols*2));
+  idma_mm_wait_for_completion(IDMA_DIR_L1_TO_L2, 0,
+                              idma_L1ToL2_2d(stage, mat + (row*ld + col)*2, cols*2, cols*2, ld*2, rows));
+}
+
+static uint32_t check_block(void) {
+  magia_gemm_block_t b;
+  uint32_t num_errors = 0;
+  uint16_t computed, expected, diff;
+
+  magia_gemm_mesh_block(&b, get_hartid(), M_SIZE, K_SIZE);
+  for (uint32_t i = 0; i < b.rows; i++) {
+    for (uint32_t j = 0; j < b.cols; j++) {
+      computed = mmio16(Z_G + ((b.row + i)*K_SIZE + b.col + j)*2);
+      expected = z_oup[i*BLK_K + j];
+      diff = (computed > expected) ? (computed - expected) : (expected - computed);
+      if (diff > DIFF_TH) {
+        num_errors++;
+#if VERBOSE > 10
+        printf("**ERROR**: Z[%0d][%0d](=0x%4x) != 0x%4x\n", b.row + i, b.col + j, computed, expected);
+#endif
+      }
+    }
+  }
+  return num_errors;
+}
+
+int main(void) {
+  uint32_t hartid = get_hartid();
+  uint32_t ty = GET_Y_ID(hartid), tx = GET_X_ID(hartid);
+  uint32_t start, single_cycles = 0, mesh_cycles;
+  uint32_t num_errors = 0;
+  uint32_t exit_code;
+
+  ccount_en();
+
+  // X row slices by the first column of tiles, W column slices by the first row, Y blocks by all
+  if (tx == 0)
+    place_block(X_G, N_SIZE, ty*BLK_M, 0, x_inp, BLK_M, N_SIZE);
+  if (ty == 0)
+    place_block(W_G, K_SIZE, 0, tx*BLK_K, w_inp, N_SIZE, BLK_K);
+  place_block(Y_G, K_SIZE, ty*BLK_M, tx*BLK_K, y_inp, BLK_M, BLK_K);
+  fsync_mm_global();
+
+  // One block on one tile
+  if (hartid == 0) {
+    start = get_cyclel();
+    if (magia_gemm_mesh_local(X_G, W_G, Y_G, Z_G, M_SIZE, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+      num_errors++;
+    single_cycles = get_cyclel() - start;
+  }
+
+  // The whole GEMM on the mesh
+  start = get_cyclel();
+  if (magia_gemm_mesh(X_G, W_G, Y_G, Z_G, M_SIZE, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+    num_errors++;
+  mesh_cycles = get_cyclel() - start;
+
+  ccount_dis();
+
+  num_errors += check_block();
+
+  if (hartid == 0) {
+    uint32_t macs     = M_SIZE*N_SIZE*K_SIZE;
+    uint32_t achieved = (macs/mesh_cycles)*100 + ((macs % mesh_cycles)*100)/mesh_cycles;
+    // NUM_HARTS blocks, each at the speed of the block alone
+    uint32_t ideal    = (macs/single_cycles)*100 + ((macs % single_cycles)*100)/single_cycles;
+    printf("%0dx%0d mesh, %0dx%0dx%0d GEMM: %0d cycles (one %0dx%0dx%0d block alone: %0d cycles)\n",
+           MESH_X_TILES, MESH_Y_TILES, M_SIZE, N_SIZE, K_SIZE, mesh_cycles,
+           BLK_M, N_SIZE, BLK_K, single_cycles);
+    printf("Throughput: %0d.%02d MAC/cycle, ideal %0d.%02d MAC/cycle (%0d%%)\n",
+           achieved/100, achieved%100, ideal/100, ideal%100, (single_cycles*100)/mesh_cycles);
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  exit_code = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+  mmio16(TEST_END_ADDR + hartid*2) = exit_code - hartid;
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Tiled GEMM Test
+ * Runs the reference GEMM from L2 with tiles that do not divide it (edge tiles
+ * on every dimension, partial sums over N), once into a separate Z and once in
+ * place on Y
+ */
+
+#include "magia_tile_utils.h"
+
+// Tiles smaller than the matrices and not dividing them
+#define MAGIA_GEMM_TILE_M (40)
+#define MAGIA_GEMM_TILE_N (24)
+#define MAGIA_GEMM_TILE_K (48)
+
+#include "magia_gemm_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+#define K_SIZE (64)
+
+#define DIFF_TH (0x0011)
+
+#define VERBOSE (0)
+
+// Results in L2 (.bss)
+static uint16_t z_buf[M_SIZE*K_SIZE];
+static uint16_t y_buf[M_SIZE*K_SIZE];
+
+static uint32_t check_z(uint32_t z) {
+  uint32_t num_errors = 0;
+  uint16_t computed, expected, diff;
+  for (int i = 0; i < M_SIZE*K_SIZE; i++) {
+    computed = mmio16(z + 2*i);
+    expected = z_oup[i];
+    diff = (computed > expected) ? (computed - expected) : (expected - computed);
+    if (diff > DIFF_TH) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: Z[%0d](=0x%4x) != 0x%4x\n", i, computed, expected);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+int main(void) {
+  uint32_t num_errors = 0;
+  uint32_t start, cycles;
+
+  ccount_en();
+
+  start = get_cyclel();
+  if (magia_gemm((uint32_t)x_inp, (uint32_t)w_inp, (uint32_t)y_inp, (uint32_t)z_buf,
+                 M_SIZE, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+    num_errors++;
+  cycles = get_cyclel() - start;
+  num_errors += check_z((uint32_t)z_buf);
+
+  printf("%0dx%0dx%0d GEMM in %0dx%0dx%0d tiles: %0d cycles\n", M_SIZE, N_SIZE, K_SIZE,
+         MAGIA_GEMM_TILE_M, MAGIA_GEMM_TILE_N, MAGIA_GEMM_TILE_K, cycles);
+
+  // In place: Z = X*W + Z
+  magia_memcpy(y_buf, y_inp, M_SIZE*K_SIZE*2);
+  if (magia_gemm((uint32_t)x_inp, (uint32_t)w_inp, (uint32_t)y_buf, (uint32_t)y_buf,
+                 M_SIZE, N_SIZE, K_SIZE, Float16) != MAGIA_GEMM_OK)
+    num_errors++;
+  num_errors += check_z((uint32_t)y_buf);
+
+  ccount_dis();
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA memcpy/memset Test and Crossover Benchmark
+ * Times the core and the iDMA on copies of growing size between L1 and L2, reports
+ * the size from which the iDMA wins, then checks magia_memcpy/magia_memset
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "magia_mem_utils.h"
+
+#include "x_input.h"
+
+#define NUM_SIZES (9)
+#define NUM_PAIRS (3)
+#define MAX_LEN   (4096)
+
+#define L1_SRC (L1_BASE + 0x00012000)
+#define L1_DST (L1_BASE + 0x00014000)
+
+#define VERBOSE (0)
+
+static const uint32_t sizes[NUM_SIZES] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+static const char *pair_names[NUM_PAIRS] = {"L1->L1", "L2->L1", "L1->L2"};
+
+// L2 buffers (.bss is linked in L2)
+static uint8_t l2_dst[MAX_LEN + 8];
+
+static uint32_t pair_dst(uint32_t p) {
+  return (p == 2) ? (uint32_t)l2_dst : L1_DST;
+}
+
+static uint32_t pair_src(uint32_t p) {
+  return (p == 1) ? (uint32_t)x_inp : L1_SRC;
+}
+
+static uint32_t pair_dir(uint32_t p) {
+  return (p == 2) ? IDMA_DIR_L1_TO_L2 : IDMA_DIR_L2_TO_L1;
+}
+
+static uint32_t time_core(uint32_t p, uint32_t len) {
+  uint32_t start = get_cyclel();
+  magia_memcpy_core(pair_dst(p), pair_src(p), len);
+  return get_cyclel() - start;
+}
+
+static uint32_t time_dma(uint32_t p, uint32_t len) {
+  uint32_t start = get_cyclel();
+  uint32_t id = idma_memcpy_large_dir(pair_dir(p), pair_src(p), pair_dst(p), len);
+  while (!idma_mm_id_retired_dir(pair_dir(p), 0, id));
+  return get_cyclel() - start;
+}
+
+static uint32_t check_bytes(uint32_t dst, uint32_t src, uint32_t len) {
+  uint32_t num_errors = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    if (mmio8(dst + i) != mmio8(src + i)) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: DST[%0d](=0x%2x) != SRC(=0x%2x)\n", i, mmio8(dst + i), mmio8(src + i));
+#endif
+    }
+  }
+  return num_errors;
+}
+
+static uint32_t check_fill(uint32_t dst, uint8_t c, uint32_t len) {
+  uint32_t num_errors = 0;
+  for (uint32_t i = 0; i < len; i++)
+    if (mmio8(dst + i) != c)
+      num_errors++;
+  return num_errors;
+}
+
+int main(void) {
+  magia_mem_req_t req_a, req_b;
+  uint32_t num_errors = 0;
+
+  magia_memcpy_core(L1_SRC, (uint32_t)x_inp, MAX_LEN);
+  ccount_en();
+
+  // Crossover
+  for (uint32_t p = 0; p < NUM_PAIRS; p++) {
+    uint32_t crossover = 0;
+    for (uint32_t s = 0; s < NUM_SIZES; s++) {
+      uint32_t core_cycles = time_core(p, sizes[s]);
+      uint32_t dma_cycles  = time_dma(p, sizes[s]);
+      printf("%s %0d B: core %0d cycles, iDMA %0d cycles\n", pair_names[p], sizes[s], core_cycles, dma_cycles);
+      if (!crossover && (dma_cycles < core_cycles))
+        crossover = sizes[s];
+    }
+    printf("%s: iDMA faster from %0d B\n", pair_names[p], crossover);
+  }
+
+  ccount_dis();
+
+  // Synchronous copies, odd sizes and offsets, on both sides of the thresholds
+  for (uint32_t s = 0; s < NUM_SIZES; s++) {
+    uint32_t len = sizes[s] - 3;
+    magia_memcpy((void *)(L1_DST + 1), (const void *)((uint32_t)x_inp + 3), len);
+    num_errors += check_bytes(L1_DST + 1, (uint32_t)x_inp + 3, len);
+    magia_memcpy((void *)(L1_DST + 2), (const void *)(L1_SRC + 1), len);
+    num_errors += check_bytes(L1_DST + 2, L1_SRC + 1, len);
+    magia_memcpy((void *)(l2_dst + 1), (const void *)(L1_SRC + 2), len);
+    num_errors += check_bytes((uint32_t)l2_dst + 1, L1_SRC + 2, len);
+  }
+
+  // memset into L1 and L2, the byte after each buffer must survive
+  for (uint32_t s = 0; s < NUM_SIZES; s++) {
+    uint32_t len = sizes[s] - 1;
+    mmio8(L1_DST + 1 + len) = 0x5A;
+    magia_memset((void *)(L1_DST + 1), 0xC3, len);
+    num_errors += check_fill(L1_DST + 1, 0xC3, len) + (mmio8(L1_DST + 1 + len) != 0x5A);
+    mmio8((uint32_t)l2_dst + 1 + len) = 0x5A;
+    magia_memset(l2_dst + 1, 0x3C, len);
+    num_errors += check_fill((uint32_t)l2_dst + 1, 0x3C, len) + (mmio8((uint32_t)l2_dst + 1 + len) != 0x5A);
+  }
+
+  // Asynchronous: one copy per direction in flight together
+  magia_memcpy_async(&req_a, (void *)L1_DST, x_inp, MAX_LEN);
+  magia_memcpy_async(&req_b, l2_dst, (const void *)L1_SRC, MAX_LEN);
+  magia_mem_wait(&req_a);
+  magia_mem_wait(&req_b);
+  num_errors += check_bytes(L1_DST, (uint32_t)x_inp, MAX_LEN);
+  num_errors += check_bytes((uint32_t)l2_dst, L1_SRC, MAX_LEN);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -34,7 +34,6 @@
 #define Y_BASE (L1_BASE + 0x0001A048)
 #define Z_BASE (L2_BASE + 0x00042000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
 #define V_BASE (L2_BASE + 0x00046000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
-#define T_BASE (L2_BASE + 0x0004A000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
 
 #define MHARTID_OFFSET (0x00010000)
 
@@ -69,13 +68,10 @@ void idma_mv_in(unsigned int x_dim, unsigned int y_dim, uint16_t src_data[], uin
   irq_en(1<<IRQ_A2O_DONE);
 #endif
 
-  for (int i = 0; i < x_dim*y_dim; i++)
-    mmio16(T_BASE + get_hartid()*MHARTID_OFFSET + 2*i) = src_data[i];
-
   idma_conf_in();
 
   dst_addr = (uint32_t)dst_address;
-  src_addr = (uint32_t)(T_BASE + get_hartid()*MHARTID_OFFSET);
+  src_addr = (uint32_t)src_data; // Program data in L2, read in place (no staging copy)
   len      = (uint32_t)(x_dim*y_dim*2); // 2 Bytes per element
 #if VERBOSE > 10
   // h_pprintf("dst_addr: 0x"); n_pprintf(hs(dst_addr));
@@ -41,7 +41,6 @@
 #define Y_BASE (L1_BASE + 0x0001A048)
 #define Z_BASE (L2_BASE + 0x00042000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
 #define V_BASE (L2_BASE + 0x00046000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
-#define T_BASE (L2_BASE + 0x0004A000) // Note: for a large number of tiles (e.g. 64x64 mesh) we might exceed memory range of L2
 
 #define MHARTID_OFFSET (0x00010000)
 
@@ -69,11 +68,9 @@ void idma_mv_in_pure_eu(unsigned int x_dim, unsigned int y_dim, uint16_t src_dat
     eu_initialized = 1;
   }
 
-  for (int i = 0; i < x_dim*y_dim; i++)
-    mmio16(T_BASE + get_hartid()*MHARTID_OFFSET + 2*i) = src_data[i];
-
+  // Source operands are read in place from the program data in L2 (no staging copy)
   dst_addr = (uint32_t)dst_address;
-  src_addr = (uint32_t)(T_BASE + get_hartid()*MHARTID_OFFSET);
+  src_addr = (uint32_t)src_data;
   len      = (uint32_t)(x_dim*y_dim*2); // 2 Bytes per element
 #if VERBOSE > 10
   printf("dst_addr: 0x%0x\n", dst_addr);
@@ -81,7 +78,7 @@ void idma_mv_in_pure_eu(unsigned int x_dim, unsigned int y_dim, uint16_t src_dat
   printf("len:        %0d\n", len);
 #endif
 
-  idma_L2ToL1(src_addr, dst_addr, len);
+  uint32_t transfer_id = idma_data_to_l1(src_data, dst_addr, len);
 
   // Clear Event Unit and ensure A2O mask is enabled
   eu_clear_events(0xFFFFFFFF);
@@ -91,7 +88,9 @@ void idma_mv_in_pure_eu(unsigned int x_dim, unsigned int y_dim, uint16_t src_dat
   eu_wait_mode_t wait_mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
   
   // Use direction-specific wait for L2->L1 (A2O, direction = 0)
-  eu_idma_wait_direction_completion(0, wait_mode);
+  // ID 0: the data was copied by the core, no done event will come
+  if (transfer_id)
+    eu_idma_wait_direction_completion(0, wait_mode);
 
 #if VERBOSE > 100
   for (int i = 0; i < x_dim*y_dim; i++){
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Multi-Core Tile Test
+ * Splits an L1 vector update across the Tile cores (make ... tile_cores=N)
+ * and checks it from core 0 after the HW barrier
+ */
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "magia_cores_utils.h"
+
+#define VEC_BASE (L1_BASE + 0x00010000)
+#define VEC_LEN  (1027)
+
+static void fill_body(uint32_t idx, void *args) {
+    volatile uint32_t *vec = (volatile uint32_t *)args;
+    vec[idx] = 3 * idx + 1;
+}
+
+int main(void) {
+  volatile uint32_t *vec = (volatile uint32_t *)VEC_BASE;
+  volatile uint32_t *out = (volatile uint32_t *)(VEC_BASE + VEC_LEN * 4);
+  uint32_t cs, ce;
+  uint32_t num_errors = 0;
+
+  eu_init();
+
+  magia_parallel_for(0, VEC_LEN, fill_body, (void *)vec);
+
+  // Second phase reads what the other cores wrote in the first one
+  magia_parallel_range(0, VEC_LEN, &cs, &ce);
+  for (uint32_t i = cs; i < ce; i++)
+    out[i] = vec[(VEC_LEN - 1) - i] * 2;
+  magia_cores_barrier();
+
+  if (get_coreid() != 0)
+    return 0;
+
+  printf("Checking %0d elements computed by %0d cores...\n", VEC_LEN, NUM_CORES);
+
+  for (uint32_t i = 0; i < VEC_LEN; i++) {
+    uint32_t expected = (3 * ((VEC_LEN - 1) - i) + 1) * 2;
+    if (out[i] != expected) {
+      num_errors++;
+      printf("Error %0d: out[%0d] = %0d, expected %0d\n", num_errors, i, out[i], expected);
+    }
+  }
+
+  uint32_t exit_code;
+  if(num_errors)
+    exit_code = FAIL_EXIT_CODE;
+  else
+    exit_code = PASS_EXIT_CODE;
+
+  mmio16(TEST_END_ADDR) = exit_code;
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Tile-to-Tile RDMA Test - Event Unit Version
+ * Every tile puts a buffer into the L1 of the next tile and notifies it,
+ * then gets the buffer of the previous tile back over the NoC
+ */
+
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+#include "event_unit_utils.h"
+#include "fsync_mm_utils.h"
+#include "fsync_mm_api.h"
+
+#define BUF_LEN (0x800)
+
+// Offsets from L1_BASE, valid on every tile
+#define SRC_OFFSET (0x00012048)
+#define RCV_OFFSET (0x00014048)
+#define GET_OFFSET (0x00016048)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static inline uint32_t pattern(uint32_t tile, uint32_t i) {
+  return (tile << 24) | i;
+}
+
+int main(void) {
+  uint32_t hartid = get_hartid();
+  uint32_t next   = (hartid + 1) % NUM_HARTS;
+  uint32_t prev   = (hartid + NUM_HARTS - 1) % NUM_HARTS;
+  uint32_t sender;
+  uint32_t id;
+  uint32_t num_errors = 0;
+  uint32_t exit_code;
+
+  eu_init();
+  eu_clear_events(0xFFFFFFFF);
+  idma_notify_init();
+
+  for (int i = 0; i < BUF_LEN/4; i++)
+    mmio32(idma_local_l1_addr(SRC_OFFSET) + 4*i) = pattern(hartid, i);
+
+  // Every tile must be ready to receive before the first put
+  fsync_mm_global();
+
+  idma_put_notify(next, RCV_OFFSET, idma_local_l1_addr(SRC_OFFSET), BUF_LEN);
+
+  sender = idma_notify_wait(USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING);
+  if (sender != prev) {
+    num_errors++;
+    printf("Notified by tile %0d, expected %0d\n", sender, prev);
+  }
+
+  for (int i = 0; i < BUF_LEN/4; i++) {
+    if (mmio32(idma_local_l1_addr(RCV_OFFSET) + 4*i) != pattern(prev, i)) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("RCV[%0d]: 0x%0x != 0x%0x\n", i, mmio32(idma_local_l1_addr(RCV_OFFSET) + 4*i), pattern(prev, i));
+#endif
+    }
+  }
+
+  // The buffer of the previous tile is static: get it back from there
+  id = idma_get(prev, idma_local_l1_addr(GET_OFFSET), SRC_OFFSET, BUF_LEN);
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+
+  for (int i = 0; i < BUF_LEN/4; i++) {
+    if (mmio32(idma_local_l1_addr(GET_OFFSET) + 4*i) != pattern(prev, i)) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("GET[%0d]: 0x%0x != 0x%0x\n", i, mmio32(idma_local_l1_addr(GET_OFFSET) + 4*i), pattern(prev, i));
+#endif
+    }
+  }
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  exit_code = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+  mmio16(TEST_END_ADDR + hartid*2) = exit_code - hartid;
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA RedMulE Data Format Test
+ * Runs the first rows of the reference GEMM in every RedMulE format, configured
+ * through the memory-mapped registers and through the ISA, against a reference
+ * computed on the core from the same inputs. FP16 and FP8 are also run from FP32
+ * data in L2, converted by the iDMA on the way in and out. Reports cycles, L1
+ * footprint and error against the FP16 golden of each format.
+ */
+
+#include "magia_tile_utils.h"
+#include "redmule_mm_utils.h"
+#include "redmule_isa_utils.h"
+#include "redmule_fmt_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+// First M_SIZE rows of the 96x64x64 golden: the reference runs on the core
+#define M_SIZE (16)
+#define N_SIZE (64)
+#define K_SIZE (64)
+
+#define X_BASE (L1_BASE + 0x00012000)
+#define W_BASE (L1_BASE + 0x00013000)
+#define Y_BASE (L1_BASE + 0x00016000)
+
+#define NUM_FMTS (4)
+
+#define VERBOSE (0)
+
+// L2 (.bss)
+static uint16_t z_ref[M_SIZE*K_SIZE];
+static uint32_t x32[M_SIZE*N_SIZE];
+static uint32_t w32[N_SIZE*K_SIZE];
+static uint32_t y32[M_SIZE*K_SIZE];
+static uint32_t z32[M_SIZE*K_SIZE];
+
+static const uint8_t fmts[NUM_FMTS] = {Float16, Float16Alt, Float8, Float8Alt};
+
+// Quantized golden inputs in L1, Y (the accumulator) too
+static void load_inputs(uint8_t fmt) {
+  redmule_fmt_convert_array(X_BASE, fmt, (uint32_t)x_inp, Float16, M_SIZE*N_SIZE);
+  redmule_fmt_convert_array(W_BASE, fmt, (uint32_t)w_inp, Float16, N_SIZE*K_SIZE);
+  redmule_fmt_convert_array(Y_BASE, fmt, (uint32_t)y_inp, Float16, M_SIZE*K_SIZE);
+}
+
+static uint32_t run_mmio(uint8_t fmt) {
+  uint32_t start = get_cyclel();
+
+  while (hwpe_acquire_job() < 0)
+    ;
+  redmule_cfg(X_BASE, W_BASE, Y_BASE, M_SIZE, N_SIZE, K_SIZE, (uint8_t)gemm_ops, fmt);
+  hwpe_trigger_job();
+  eu_redmule_wait_completion(EU_WAIT_MODE_WFE);
+
+  return get_cyclel() - start;
+}
+
+static void run_isa(uint8_t fmt) {
+  redmule_mcnfig(K_SIZE, M_SIZE, N_SIZE);
+  redmule_marith_fmt(Y_BASE, W_BASE, X_BASE, fmt);
+  eu_redmule_wait_completion(EU_WAIT_MODE_WFE);
+}
+
+static uint32_t check(const char *path, uint8_t fmt) {
+  uint32_t max_diff;
+  uint32_t num_errors = redmule_fmt_check(Y_BASE, (uint32_t)z_ref, M_SIZE*K_SIZE, fmt, redmule_fmt_th(fmt), &max_diff);
+
+#if VERBOSE > 10
+  printf("%s %s: %0d error(s), max %0d ULP\n", redmule_fmt_name(fmt), path, num_errors, max_diff);
+#endif
+  return num_errors;
+}
+
+// FP32 operands in L2, narrowed to fmt by the iDMA, Z widened back to FP32
+static uint32_t run_mixed(uint8_t fmt) {
+  uint32_t narrow = (fmt == Float8) ? IDMA_XFORM_FP32_FP8 : IDMA_XFORM_FP32_FP16;
+  uint32_t widen  = (fmt == Float8) ? IDMA_XFORM_FP8_FP32 : IDMA_XFORM_FP16_FP32;
+  uint32_t num_errors = 0;
+
+  // The quantized inputs, exact in FP32
+  for (int i = 0; i < M_SIZE*N_SIZE; i++)
+    mmio32((uint32_t)x32 + 4*i) = redmule_fmt_to_fp32(redmule_fmt_load(X_BASE, i, fmt), fmt);
+  for (int i = 0; i < N_SIZE*K_SIZE; i++)
+    mmio32((uint32_t)w32 + 4*i) = redmule_fmt_to_fp32(redmule_fmt_load(W_BASE, i, fmt), fmt);
+  for (int i = 0; i < M_SIZE*K_SIZE; i++)
+    mmio32((uint32_t)y32 + 4*i) = redmule_fmt_to_fp32(redmule_fmt_convert(y_inp[i], Float16, fmt), fmt);
+
+  idma_L2ToL1_fp32_narrow((uint32_t)x32, X_BASE, M_SIZE*N_SIZE, narrow);
+  idma_L2ToL1_fp32_narrow((uint32_t)w32, W_BASE, N_SIZE*K_SIZE, narrow);
+  idma_L2ToL1_fp32_narrow((uint32_t)y32, Y_BASE, M_SIZE*K_SIZE, narrow);
+  run_mmio(fmt);
+  idma_L1ToL2_fp32_widen(Y_BASE, (uint32_t)z32, M_SIZE*K_SIZE, widen);
+
+  for (int i = 0; i < M_SIZE*K_SIZE; i++)
+    if (redmule_fmt_ulp_diff(redmule_fp32_to_fmt(mmio32((uint32_t)z32 + 4*i), fmt),
+                             redmule_fmt_load((uint32_t)z_ref, i, fmt), fmt) > redmule_fmt_th(fmt))
+      num_errors++;
+  return num_errors;
+}
+
+int main(void) {
+  uint32_t num_errors = 0;
+  uint32_t cycles[NUM_FMTS], max_err[NUM_FMTS], sum_err[NUM_FMTS];
+
+  ccount_en();
+  hwpe_soft_clear();
+  eu_redmule_init(0);
+
+  for (int f = 0; f < NUM_FMTS; f++) {
+    uint8_t fmt = fmts[f];
+
+    // Reference from the quantized inputs
+    load_inputs(fmt);
+    redmule_fmt_ref_gemm(X_BASE, W_BASE, Y_BASE, (uint32_t)z_ref, M_SIZE, N_SIZE, K_SIZE, fmt);
+
+    cycles[f] = run_mmio(fmt);
+    num_errors += check("MMIO", fmt);
+
+    // Error of the format against the FP16 golden, in FP16 ULPs
+    max_err[f] = sum_err[f] = 0;
+    for (int i = 0; i < M_SIZE*K_SIZE; i++) {
+      uint32_t diff = redmule_fmt_ulp_diff(redmule_fmt_convert(redmule_fmt_load(Y_BASE, i, fmt), fmt, Float16),
+                                           z_oup[i], Float16);
+      sum_err[f] += diff;
+      if (diff > max_err[f])
+        max_err[f] = diff;
+    }
+
+    redmule_fmt_convert_array(Y_BASE, fmt, (uint32_t)y_inp, Float16, M_SIZE*K_SIZE);
+    run_isa(fmt);
+    num_errors += check("ISA", fmt);
+
+    if ((fmt == Float16) || (fmt == Float8))
+      num_errors += run_mixed(fmt);
+  }
+
+  ccount_dis();
+
+  printf("%0dx%0dx%0d GEMM per format (error vs FP16 golden in FP16 ULPs):\n", M_SIZE, N_SIZE, K_SIZE);
+  for (int f = 0; f < NUM_FMTS; f++)
+    printf("  %s: %0d cycles, %0d B of operands, error max %0d mean %0d\n", redmule_fmt_name(fmts[f]), cycles[f],
+           (M_SIZE*N_SIZE + N_SIZE*K_SIZE + M_SIZE*K_SIZE)*redmule_fmt_bytes(fmts[f]),
+           max_err[f], sum_err[f]/(M_SIZE*K_SIZE));
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA RedMulE Job Queue Test - Event Unit Version
+ * Splits the reference GEMM in row blocks and runs them one at a time
+ * (acquire, configure, trigger, wait) and then through the job queue
+ */
+
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "redmule_mm_utils.h"
+#include "redmule_queue_utils.h"
+#include "event_unit_utils.h"
+
+#include "x_input.h"
+#include "w_input.h"
+#include "y_input.h"
+#include "z_output.h"
+
+#define X_BASE (L1_BASE + 0x00012048)
+#define W_BASE (L1_BASE + 0x00016048)
+#define Y_BASE (L1_BASE + 0x0001A048)
+
+#define M_SIZE (96)
+#define N_SIZE (64)
+#define K_SIZE (64)
+
+#define NUM_JOBS (4)
+#define JOB_M    (M_SIZE/NUM_JOBS)
+
+#define DIFF_TH (0x0011)
+
+#define VERBOSE (0)
+
+#define USE_WFE (1)
+
+static void load_y(void) {
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, idma_L2ToL1((uint32_t)y_inp, Y_BASE, M_SIZE*K_SIZE*2));
+}
+
+static uint32_t check_y(void) {
+  uint32_t num_errors = 0;
+  uint16_t computed, expected, diff;
+  for (int i = 0; i < M_SIZE*K_SIZE; i++) {
+    computed = mmio16(Y_BASE + 2*i);
+    expected = z_oup[i];
+    diff = (computed > expected) ? (computed - expected) : (expected - computed);
+    if (diff > DIFF_TH) {
+      num_errors++;
+#if VERBOSE > 10
+      printf("**ERROR**: Y[%0d](=0x%4x) != Z(=0x%4x)\n", i, computed, expected);
+#endif
+    }
+  }
+  return num_errors;
+}
+
+int main(void) {
+  eu_wait_mode_t mode = USE_WFE ? EU_WAIT_MODE_WFE : EU_WAIT_MODE_POLLING;
+  redmule_queue_t q;
+  uint32_t num_errors = 0;
+  uint32_t start, serial_cycles, queued_cycles;
+
+  eu_init();
+
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, idma_L2ToL1((uint32_t)x_inp, X_BASE, M_SIZE*N_SIZE*2));
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, idma_L2ToL1((uint32_t)w_inp, W_BASE, N_SIZE*K_SIZE*2));
+
+  ccount_en();
+
+  // One job at a time
+  load_y();
+  hwpe_soft_clear();
+  start = get_cyclel();
+  for (uint32_t j = 0; j < NUM_JOBS; j++) {
+    while (hwpe_acquire_job() < 0)
+      ;
+    redmule_cfg(X_BASE + j*JOB_M*N_SIZE*2, W_BASE, Y_BASE + j*JOB_M*K_SIZE*2,
+                JOB_M, N_SIZE, K_SIZE, (uint8_t)gemm_ops, (uint8_t)Float16);
+    hwpe_trigger_job();
+    hwpe_wait_for_completion();
+  }
+  serial_cycles = get_cyclel() - start;
+  num_errors += check_y();
+
+  // Job i+1 programmed while job i runs
+  load_y();
+  redmule_queue_init(&q, mode);
+  start = get_cyclel();
+  for (uint32_t j = 0; j < NUM_JOBS; j++)
+    redmule_queue_push(&q, X_BASE + j*JOB_M*N_SIZE*2, W_BASE, Y_BASE + j*JOB_M*K_SIZE*2,
+                       JOB_M, N_SIZE, K_SIZE, (uint8_t)Float16);
+  redmule_queue_drain(&q);
+  queued_cycles = get_cyclel() - start;
+  num_errors += check_y();
+
+  ccount_dis();
+
+  printf("%0d jobs of %0dx%0dx%0d: %0d cycles one at a time, %0d queued\n",
+         NUM_JOBS, JOB_M, N_SIZE, K_SIZE, serial_cycles, queued_cycles);
+
+  printf("Finished test with %0d error(s)\n", num_errors);
+
+  mmio16(TEST_END_ADDR) = num_errors ? FAIL_EXIT_CODE : PASS_EXIT_CODE;
+
+  return 0;
+}
@@ -33,7 +33,6 @@
 #define Y_BASE (L1_BASE + 0x0001A048)
 #define Z_BASE (L2_BASE + 0x00042000)
 #define V_BASE (L2_BASE + 0x00046000)
-#define T_BASE (L2_BASE + 0x0004A000)
 
 #define M_SIZE (96)
 #define N_SIZE (64)
@@ -66,13 +65,10 @@ void idma_mv_in(unsigned int x_dim, unsigned int y_dim, uint16_t src_data[], uin
   irq_en(1<<IRQ_A2O_DONE);
 #endif
 
-  for (int i = 0; i < x_dim*y_dim; i++)
-    mmio16(T_BASE + 2*i) = src_data[i];
-
   idma_conf_in();
 
   dst_addr = (uint32_t)dst_address;
-  src_addr = (uint32_t)T_BASE;
+  src_addr = (uint32_t)src_data; // Program data in L2, read in place (no staging copy)
   len      = (uint32_t)(x_dim*y_dim*2); // 2 Bytes per element
 #if VERBOSE > 10
   printf("dst_addr: 0x%8x\n", dst_addr);
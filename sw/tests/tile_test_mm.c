@@ -34,7 +34,6 @@
 #define Y_BASE (L1_BASE + 0x0001A048)
 #define Z_BASE (L2_BASE + 0x00042000)
 #define V_BASE (L2_BASE + 0x00046000)
-#define T_BASE (L2_BASE + 0x0004A000)
 
 #define M_SIZE (96)
 #define N_SIZE (64)
@@ -59,11 +58,9 @@ void idma_mv_in(unsigned int x_dim, unsigned int y_dim, uint16_t src_data[], uin
   irq_en(1<<IRQ_A2O_DONE);
 #endif
 
-  for (int i = 0; i < x_dim*y_dim; i++)
-    mmio16(T_BASE + 2*i) = src_data[i];
-
+  // Source operands are read in place from the program data in L2 (no staging copy)
   dst_addr = (uint32_t)dst_address;
-  src_addr = (uint32_t)T_BASE;
+  src_addr = (uint32_t)src_data;
   len      = (uint32_t)(x_dim*y_dim*2); // 2 Bytes per element
 #if VERBOSE > 10
   printf("dst_addr: 0x%8x\n", dst_addr);
@@ -71,11 +68,14 @@ void idma_mv_in(unsigned int x_dim, unsigned int y_dim, uint16_t src_data[], uin
   printf("len: %0d\n", len);
 #endif
 
-  uint32_t transfer_id = idma_L2ToL1(src_addr, dst_addr, len);
+  uint32_t transfer_id = idma_data_to_l1(src_data, dst_addr, len);
 
 #ifdef IRQ_EN
-  asm volatile("wfi" ::: "memory");
-  printf("Detected IRQ...\n");
+  // ID 0: the data was copied by the core, no done IRQ will come
+  if (transfer_id) {
+    asm volatile("wfi" ::: "memory");
+    printf("Detected IRQ...\n");
+  }
 #else
   dma_wait(transfer_id);
 #endif
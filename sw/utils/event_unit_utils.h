@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
 
 //=============================================================================
 // Event Unit Register Map - Base addresses and offsets
@@ -32,27 +33,36 @@
 
 #define EU_BASE                      EVENT_UNIT_BASE       
 
+// Per-core register banks (0x40 * core_id offset) - each core uses its own one
+#define EU_CORE_AREA_SIZE            0x40
+#if NUM_CORES > 1
+#define EU_CORE_BASE                 (EU_BASE + EU_CORE_AREA_SIZE * get_coreid())
+#else
+#define EU_CORE_BASE                 (EU_BASE)
+#endif
+
 // Core Event Unit registers - Main control and status
-#define EU_CORE_MASK                 (EU_BASE + 0x00)          // R/W: Event mask (enables event lines)
-#define EU_CORE_MASK_AND             (EU_BASE + 0x04)          // W: Clear bits in mask
-#define EU_CORE_MASK_OR              (EU_BASE + 0x08)          // W: Set bits in mask
-#define EU_CORE_IRQ_MASK             (EU_BASE + 0x0C)          // R/W: IRQ event mask
-#define EU_CORE_IRQ_MASK_AND         (EU_BASE + 0x10)          // W: Clear IRQ mask bits
-#define EU_CORE_IRQ_MASK_OR          (EU_BASE + 0x14)          // W: Set IRQ mask bits
-#define EU_CORE_STATUS               (EU_BASE + 0x18)          // R: Core clock status
-#define EU_CORE_BUFFER               (EU_BASE + 0x1C)          // R: Event buffer
-#define EU_CORE_BUFFER_MASKED        (EU_BASE + 0x20)          // R: Buffer with mask applied
-#define EU_CORE_BUFFER_IRQ_MASKED    (EU_BASE + 0x24)          // R: Buffer with IRQ mask
-#define EU_CORE_BUFFER_CLEAR         (EU_BASE + 0x28)          // W: Clear received events
-#define EU_CORE_SW_EVENTS_MASK       (EU_BASE + 0x2C)          // R/W: SW event target mask
-#define EU_CORE_SW_EVENTS_MASK_AND   (EU_BASE + 0x30)          // W: Clear SW target bits
-#define EU_CORE_SW_EVENTS_MASK_OR    (EU_BASE + 0x34)          // W: Set SW target bits
+#define EU_CORE_MASK                 (EU_CORE_BASE + 0x00)     // R/W: Event mask (enables event lines)
+#define EU_CORE_MASK_AND             (EU_CORE_BASE + 0x04)     // W: Clear bits in mask
+#define EU_CORE_MASK_OR              (EU_CORE_BASE + 0x08)     // W: Set bits in mask
+#define EU_CORE_IRQ_MASK             (EU_CORE_BASE + 0x0C)     // R/W: IRQ event mask
+#define EU_CORE_IRQ_MASK_AND         (EU_CORE_BASE + 0x10)     // W: Clear IRQ mask bits
+#define EU_CORE_IRQ_MASK_OR          (EU_CORE_BASE + 0x14)     // W: Set IRQ mask bits
+#define EU_CORE_STATUS               (EU_CORE_BASE + 0x18)     // R: Core clock status
+#define EU_CORE_BUFFER               (EU_CORE_BASE + 0x1C)     // R: Event buffer
+#define EU_CORE_BUFFER_MASKED        (EU_CORE_BASE + 0x20)     // R: Buffer with mask applied
+#define EU_CORE_BUFFER_IRQ_MASKED    (EU_CORE_BASE + 0x24)     // R: Buffer with IRQ mask
+#define EU_CORE_BUFFER_CLEAR         (EU_CORE_BASE + 0x28)     // W: Clear received events
+#define EU_CORE_SW_EVENTS_MASK       (EU_CORE_BASE + 0x2C)     // R/W: SW event target mask
+#define EU_CORE_SW_EVENTS_MASK_AND   (EU_CORE_BASE + 0x30)     // W: Clear SW target bits
+#define EU_CORE_SW_EVENTS_MASK_OR    (EU_CORE_BASE + 0x34)     // W: Set SW target bits
 
 // Core Event Unit wait registers - Sleep functionality
-#define EU_CORE_EVENT_WAIT           (EU_BASE + 0x38)          // R: Sleep until event
-#define EU_CORE_EVENT_WAIT_CLEAR     (EU_BASE + 0x3C)          // R: Sleep + clear buffer
+#define EU_CORE_EVENT_WAIT           (EU_CORE_BASE + 0x38)     // R: Sleep until event
+#define EU_CORE_EVENT_WAIT_CLEAR     (EU_CORE_BASE + 0x3C)     // R: Sleep + clear buffer
 
 // Hardware barrier registers (0x20 * barr_id offset)
+#define HW_BARR_AREA_SIZE            0x20
 #define HW_BARR_TRIGGER_MASK         (EU_BASE + 0x400)         // R/W: Barrier trigger mask
 #define HW_BARR_STATUS               (EU_BASE + 0x404)         // R: Barrier status
 #define HW_BARR_TARGET_MASK          (EU_BASE + 0x40C)         // R/W: Barrier target mask
@@ -140,6 +150,20 @@
 #define EU_FSYNC_ERROR_MASK          (1 << EU_FSYNC_ERROR_BIT) // 0x02000000
 #define EU_FSYNC_ALL_MASK            (EU_FSYNC_DONE_MASK | EU_FSYNC_ERROR_MASK) // 0x03000000
 
+// FSync broadcast event (via cluster_events_i[23]), raised on every listener of the subtree
+#define EU_FSYNC_BCAST_BIT           23                        // FSync broadcast received
+#define EU_FSYNC_BCAST_MASK          (1 << EU_FSYNC_BCAST_BIT) // 0x00800000
+
+// NoC notification event (via cluster_events_i[22]), raised by a remote write to the L1 notification word
+#define EU_NOC_NOTIFY_BIT            22                        // NoC notification received
+#define EU_NOC_NOTIFY_MASK           (1 << EU_NOC_NOTIFY_BIT)  // 0x00400000
+
+// iDMA descriptor chain events (via cluster_events_i[21:20]), raised at the end of a chain and at every fence
+#define EU_IDMA_A2O_CHAIN_BIT        20                        // iDMA AXI2OBI chain done/fence
+#define EU_IDMA_O2A_CHAIN_BIT        21                        // iDMA OBI2AXI chain done/fence
+#define EU_IDMA_A2O_CHAIN_MASK       (1 << EU_IDMA_A2O_CHAIN_BIT) // 0x00100000
+#define EU_IDMA_O2A_CHAIN_MASK       (1 << EU_IDMA_O2A_CHAIN_BIT) // 0x00200000
+
 // Legacy compatibility - use DONE by default
 #define EU_FSYNC_EVT_BIT             EU_FSYNC_DONE_BIT         // bit 24 - Legacy compatibility
 #define EU_FSYNC_EVT_MASK            EU_FSYNC_DONE_MASK        // 0x01000000 - Legacy compatibility
@@ -266,6 +290,26 @@ static inline uint32_t eu_wait_events(uint32_t event_mask, eu_wait_mode_t mode,
     }
 }
 
+//=============================================================================
+// Hardware Barrier Functions - Multi-core Tiles only
+//=============================================================================
+
+static inline void eu_barrier_setup(uint32_t barr_id, uint32_t core_mask) {
+    mmio32(HW_BARR_TRIGGER_MASK + barr_id * HW_BARR_AREA_SIZE) = core_mask;
+    mmio32(HW_BARR_TARGET_MASK + barr_id * HW_BARR_AREA_SIZE) = core_mask;
+}
+
+static inline void eu_barrier_trigger(uint32_t barr_id) {
+    mmio32(HW_BARR_TRIGGER + barr_id * HW_BARR_AREA_SIZE) = 1 << get_coreid();
+}
+
+// The barrier event is raised on the sync line of every core in the target mask
+static inline uint32_t eu_barrier_wait(uint32_t barr_id, eu_wait_mode_t mode) {
+    eu_enable_events(EU_SYNC_EVT_MASK);
+    eu_barrier_trigger(barr_id);
+    return eu_wait_events(EU_SYNC_EVT_MASK, mode, 0);
+}
+
 //=============================================================================
 // RedMulE Functions
 //=============================================================================
@@ -362,6 +406,53 @@ static inline uint32_t eu_idma_o2a_is_busy(void) {
     return eu_check_events(EU_IDMA_O2A_BUSY_MASK);
 }
 
+// Transfer ID wait: the core sleeps on the done event of the direction and reads the
+// done ID only when woken, so an idle wait issues no request on the interconnect.
+// A done event of another job (or a stale one) only costs one more done ID read.
+static inline void eu_idma_wait_id(uint32_t is_l1_to_l2, uint32_t stream, uint32_t transfer_id, eu_wait_mode_t mode) {
+    uint32_t wait_mask = is_l1_to_l2 ? EU_IDMA_O2A_DONE_MASK : EU_IDMA_A2O_DONE_MASK;
+
+    if (transfer_id == 0)
+        return;
+
+    eu_enable_events(wait_mask);
+
+    // The event of a job retiring after the check stays buffered: no lost wake-up
+    while (!idma_mm_id_retired_dir(is_l1_to_l2, stream, transfer_id))
+        eu_wait_events(wait_mask, mode, 0);
+}
+
+static inline void eu_idma_wait_queue(idma_queue_t *q, eu_wait_mode_t mode) {
+    eu_idma_wait_id(q->is_l1_to_l2, q->stream, q->last_id, mode);
+}
+
+// Done events of a direction are raised every k retired jobs, timeout cycles after the
+// first pending one, or when the channel goes idle, whichever comes first. k = 0/1
+// restores one event per job, timeout = 0 disables the timer. eu_idma_wait_id checks
+// the retired ID on every wake-up, so it works unchanged with any setting.
+static inline void eu_idma_set_coalescing(uint32_t is_l1_to_l2, uint32_t k, uint32_t timeout) {
+    mmio32(IDMA_COALESCE_COUNT_ADDR(is_l1_to_l2))   = k;
+    mmio32(IDMA_COALESCE_TIMEOUT_ADDR(is_l1_to_l2)) = timeout;
+}
+
+// Sleeps until the next fence or the end of the running chain of a direction
+static inline void eu_idma_wait_chain_event(uint32_t is_l1_to_l2, eu_wait_mode_t mode) {
+    uint32_t wait_mask = is_l1_to_l2 ? EU_IDMA_O2A_CHAIN_MASK : EU_IDMA_A2O_CHAIN_MASK;
+
+    eu_enable_events(wait_mask);
+    eu_wait_events(wait_mask, mode, 0);
+}
+
+// Sleeps until the chain of a direction is over, skipping its fences
+static inline void eu_idma_wait_chain(uint32_t is_l1_to_l2, eu_wait_mode_t mode) {
+    uint32_t wait_mask = is_l1_to_l2 ? EU_IDMA_O2A_CHAIN_MASK : EU_IDMA_A2O_CHAIN_MASK;
+
+    eu_enable_events(wait_mask);
+
+    while (idma_chain_busy(is_l1_to_l2))
+        eu_wait_events(wait_mask, mode, 0);
+}
+
 //=============================================================================
 // FSync Functions
 //=============================================================================
@@ -387,6 +478,16 @@ static inline uint32_t eu_fsync_has_error(void) {
     return eu_check_events(EU_FSYNC_ERROR_MASK);
 }
 
+static inline uint32_t eu_fsync_wait_bcast(eu_wait_mode_t mode) {
+    eu_enable_events(EU_FSYNC_BCAST_MASK);
+    return eu_wait_events(EU_FSYNC_BCAST_MASK, mode, 0);
+}
+
+static inline uint32_t eu_noc_wait_notify(eu_wait_mode_t mode) {
+    eu_enable_events(EU_NOC_NOTIFY_MASK);
+    return eu_wait_events(EU_NOC_NOTIFY_MASK, mode, 0);
+}
+
 //=============================================================================
 // Multi-Accelerator Functions
 //=============================================================================
@@ -98,8 +98,40 @@
     fsync_mm(id, _FS_MM_RC_AGGR);
   }
 
-  static inline void fsync_mm_global(){
-    fsync_mm(_FS_MM_GLOBAL_ID, _FS_MM_GLOBAL_AGGR);
+  static inline int fsync_mm_global(){
+    return fsync_mm(_FS_MM_GLOBAL_ID, _FS_MM_GLOBAL_AGGR);
+  }
+
+  static inline void fsync_mm_bcast_global_listen(){
+    fsync_mm_bcast_listen(_FS_MM_GLOBAL_ID, _FS_MM_GLOBAL_AGGR);
+  }
+
+  static inline int fsync_mm_bcast_global_send(){
+    return fsync_mm_bcast_send(_FS_MM_GLOBAL_ID, _FS_MM_GLOBAL_AGGR);
+  }
+
+  void fsync_mm_bcast_rows_listen(){
+    uint32_t hartid   = get_hartid();
+    uint32_t hartid_y = GET_Y_ID(hartid);
+    fsync_mm_bcast_listen(row_id_lookup_mm(hartid_y), _FS_MM_RC_AGGR);
+  }
+
+  int fsync_mm_bcast_rows_send(){
+    uint32_t hartid   = get_hartid();
+    uint32_t hartid_y = GET_Y_ID(hartid);
+    return fsync_mm_bcast_send(row_id_lookup_mm(hartid_y), _FS_MM_RC_AGGR);
+  }
+
+  void fsync_mm_bcast_cols_listen(){
+    uint32_t hartid   = get_hartid();
+    uint32_t hartid_x = GET_X_ID(hartid);
+    fsync_mm_bcast_listen(col_id_lookup_mm(hartid_x), _FS_MM_RC_AGGR);
+  }
+
+  int fsync_mm_bcast_cols_send(){
+    uint32_t hartid   = get_hartid();
+    uint32_t hartid_x = GET_X_ID(hartid);
+    return fsync_mm_bcast_send(col_id_lookup_mm(hartid_x), _FS_MM_RC_AGGR);
   }
 
 
@@ -19,6 +19,8 @@
  * 
  * MAGIA FractalSync Memory-Mapped Utils
  * WARNING: Make sure to undefine EVENT_UNIT in this file if POLLING in registers mm is desired, otherwise polling mode will not work correctly
+ * The Tile has one FSync port: on multi-core Tiles synchronize from core 0 only, or under
+ * magia_tile_lock() (magia_cores_utils.h)
  */
 
 #ifndef FSYNC_MM_UTILS_H
@@ -32,14 +34,36 @@
 #define FSYNC_MM_ID_REG_OFFSET      (0x04)
 #define FSYNC_MM_CONTROL_REG_OFFSET (0x08)
 #define FSYNC_MM_STATUS_REG_OFFSET  (0x0C)
+#define FSYNC_MM_BCAST_REG_OFFSET   (0x10)
 
 /* Status register bits */
 #define FSYNC_MM_STATUS_BUSY_MASK   (1 << 2)
+#define FSYNC_MM_STATUS_LISTEN_MASK (1 << 3)
 
-/* Memory-mapped sync function */
-static inline void fsync_mm(volatile uint32_t id, volatile uint32_t aggregate){
+/* Broadcast register bits */
+#define FSYNC_MM_BCAST_LISTEN       (1 << 0)
+
+/* fsync_mm() return codes */
+#define FSYNC_MM_OK                 (0)
+#define FSYNC_MM_LISTENING          (-1)  // A broadcast listener owns the controller: nothing issued
+
+/* The controller drops (with an OBI error) AGGR/ID/CONTROL writes while a listener
+ * is enabled or its last request is still armed */
+static inline uint32_t fsync_mm_listen_lock(){
+  volatile char *fsync_base = (volatile char *)(FSYNC_BASE);
+
+  return ((*(volatile uint32_t *)(fsync_base + FSYNC_MM_BCAST_REG_OFFSET) & FSYNC_MM_BCAST_LISTEN) != 0) ||
+         ((*(volatile uint32_t *)(fsync_base + FSYNC_MM_STATUS_REG_OFFSET) & FSYNC_MM_STATUS_LISTEN_MASK) != 0);
+}
+
+/* Memory-mapped sync function: returns FSYNC_MM_LISTENING, without issuing the sync
+ * (so without any event to wait for), on a tile with a broadcast listener */
+static inline int fsync_mm(volatile uint32_t id, volatile uint32_t aggregate){
   volatile char *fsync_base = (volatile char *)(FSYNC_BASE);
-  
+
+  if (fsync_mm_listen_lock())
+    return FSYNC_MM_LISTENING;
+
   *(volatile uint32_t *)(fsync_base + FSYNC_MM_AGGR_REG_OFFSET) = aggregate;
   *(volatile uint32_t *)(fsync_base + FSYNC_MM_ID_REG_OFFSET) = id;
   *(volatile uint32_t *)(fsync_base + FSYNC_MM_CONTROL_REG_OFFSET) = 1;
@@ -51,6 +75,42 @@ static inline void fsync_mm(volatile uint32_t id, volatile uint32_t aggregate){
     status = *(volatile uint32_t *)(fsync_base + FSYNC_MM_STATUS_REG_OFFSET);
   } while (status & FSYNC_MM_STATUS_BUSY_MASK);
 #endif
+  return FSYNC_MM_OK;
+}
+
+/* Broadcast listener: keeps a sync armed on the (id, aggregate) subtree and
+ * raises the FSync broadcast event each time another tile of the subtree
+ * issues fsync_mm_bcast_send() with the same configuration.
+ * Regular fsync_mm() calls are refused (FSYNC_MM_LISTENING) while listening, and
+ * until the request armed before fsync_mm_bcast_stop() is released.
+ * The listener re-arms as soon as it gets a broadcast, and the event is a single
+ * buffered Event Unit bit: broadcasts sent before the previous one was consumed
+ * coalesce into one event. Senders that need every event seen must wait for an
+ * acknowledgement from the listeners before broadcasting again. */
+static inline void fsync_mm_bcast_listen(volatile uint32_t id, volatile uint32_t aggregate){
+  volatile char *fsync_base = (volatile char *)(FSYNC_BASE);
+
+  *(volatile uint32_t *)(fsync_base + FSYNC_MM_AGGR_REG_OFFSET) = aggregate;
+  *(volatile uint32_t *)(fsync_base + FSYNC_MM_ID_REG_OFFSET) = id;
+  *(volatile uint32_t *)(fsync_base + FSYNC_MM_BCAST_REG_OFFSET) = FSYNC_MM_BCAST_LISTEN;
+}
+
+/* Stops re-arming the listener: an already armed request is released by the next broadcast */
+static inline void fsync_mm_bcast_stop(){
+  volatile char *fsync_base = (volatile char *)(FSYNC_BASE);
+
+  *(volatile uint32_t *)(fsync_base + FSYNC_MM_BCAST_REG_OFFSET) = 0;
+}
+
+static inline uint32_t fsync_mm_bcast_is_listening(){
+  volatile char *fsync_base = (volatile char *)(FSYNC_BASE);
+
+  return (*(volatile uint32_t *)(fsync_base + FSYNC_MM_STATUS_REG_OFFSET) & FSYNC_MM_STATUS_LISTEN_MASK) != 0;
+}
+
+/* Broadcast sender: a regular sync, completed once every listener of the subtree is armed */
+static inline int fsync_mm_bcast_send(volatile uint32_t id, volatile uint32_t aggregate){
+  return fsync_mm(id, aggregate);
 }
 
 #endif /*FSYNC_MM_UTILS_H*/
\ No newline at end of file
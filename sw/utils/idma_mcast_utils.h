@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Multicast DMA
+ * Delivers one buffer to a set of tiles through a binomial tree of L1-to-L1 puts,
+ * so L2 is read once per multicast instead of once per tile
+ */
+
+#ifndef IDMA_MCAST_UTILS_H
+#define IDMA_MCAST_UTILS_H
+
+#include <stdint.h>
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+#include "event_unit_utils.h"
+
+//=============================================================================
+// Tile Sets
+//=============================================================================
+// A set is an array of tile IDs, the first one being the root that holds the data.
+// tiles == 0 stands for all the tiles of the mesh, rooted at tile 0. Every tile of
+// the set calls the same function with the same arguments (SPMD), the others don't.
+// In round r the tiles at positions p < 2^r forward to position p + 2^r, so the
+// buffer reaches n tiles in ceil(log2(n)) rounds and every tile gets one put only.
+
+#define IDMA_MCAST_NOT_MEMBER (0xFFFFFFFF)
+
+static inline uint32_t idma_mcast_tile(const uint32_t *tiles, uint32_t pos) {
+  return tiles ? tiles[pos] : pos;
+}
+
+static inline uint32_t idma_mcast_pos(const uint32_t *tiles, uint32_t num_tiles, uint32_t tile) {
+  for (uint32_t p = 0; p < num_tiles; p++)
+    if (idma_mcast_tile(tiles, p) == tile)
+      return p;
+  return IDMA_MCAST_NOT_MEMBER;
+}
+
+//=============================================================================
+// Multicast
+//=============================================================================
+// The buffer lives at the same offset from L1_BASE on every tile. idma_notify_init must
+// have run on all the tiles of the set, and the destinations must be free, before the
+// root starts (e.g. after a global barrier). Returns once the local copy has landed and
+// the forwards of this tile have completed.
+
+static inline void idma_mcast(const uint32_t *tiles, uint32_t num_tiles, uint32_t offset, uint32_t len,
+                              eu_wait_mode_t mode) {
+  uint32_t pos = idma_mcast_pos(tiles, num_tiles, get_hartid());
+  uint32_t step, id = 0;
+
+  if (pos == IDMA_MCAST_NOT_MEMBER)
+    return;
+
+  // Wait for the parent: the highest power of two not above pos
+  step = 1;
+  if (pos) {
+    while (2*step <= pos)
+      step *= 2;
+    idma_notify_wait(mode);
+    step *= 2;
+  }
+
+  for (; pos + step < num_tiles; step *= 2)
+    id = idma_put_notify(idma_mcast_tile(tiles, pos + step), offset, idma_local_l1_addr(offset), len);
+
+  if (id)
+    idma_mm_wait_for_completion(IDMA_DIR_L1_TO_L2, 0, id);
+}
+
+// The root loads the buffer from L2 first, the tree does the rest
+static inline void idma_mcast_from_l2(const uint32_t *tiles, uint32_t num_tiles, uint32_t offset,
+                                      uint32_t l2_src, uint32_t len, eu_wait_mode_t mode) {
+  if (get_hartid() == idma_mcast_tile(tiles, 0))
+    idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0,
+                                idma_L2ToL1_large(l2_src, idma_local_l1_addr(offset), len));
+
+  idma_mcast(tiles, num_tiles, offset, len, mode);
+}
+
+#endif // IDMA_MCAST_UTILS_H
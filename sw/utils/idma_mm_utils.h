@@ -18,6 +18,8 @@
  *         Based on idma_utils.h by Victor Isachi
  * 
  * MAGIA iDMA Memory-Mapped I/O Utils
+ * The Tile has one iDMA: on multi-core Tiles call these from core 0 only, or under
+ * magia_tile_lock() (magia_cores_utils.h)
  */
 
 #ifndef IDMA_MM_UTILS_H
@@ -48,6 +50,13 @@
 #define IDMA_DST_STRIDE_3_LOW_OFFSET (0x100)
 #define IDMA_SRC_STRIDE_3_LOW_OFFSET (0x108)
 #define IDMA_REPS_3_LOW_OFFSET    (0x110)
+#define IDMA_CHAIN_HEAD_OFFSET    (0x180) // W: first descriptor, starts the chain; R: current descriptor
+#define IDMA_CHAIN_STATUS_OFFSET  (0x184) // R: [0] chain running
+#define IDMA_CHAIN_LAST_ID_OFFSET (0x188) // R: ID of the last job launched by the chain
+#define IDMA_COALESCE_COUNT_OFFSET   (0x190) // R/W: done event every K retired jobs, 0/1 = every job
+#define IDMA_COALESCE_TIMEOUT_OFFSET (0x194) // R/W: done event at most N cycles after the first pending job, 0 = none
+#define IDMA_XFORM_MODE_OFFSET       (0x198) // R/W: L1 data transform mode (IDMA_XFORM_*)
+#define IDMA_XFORM_ARG_OFFSET        (0x19C) // R/W: fill pattern or L1 address of the packed buffer
 
 // Register Addresses - now direction-aware
 #define IDMA_CONF_ADDR(is_l1_to_l2)          ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_CONF_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_CONF_OFFSET))
@@ -63,6 +72,13 @@
 #define IDMA_DST_STRIDE_3_LOW_ADDR(is_l1_to_l2) ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_DST_STRIDE_3_LOW_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_DST_STRIDE_3_LOW_OFFSET))
 #define IDMA_SRC_STRIDE_3_LOW_ADDR(is_l1_to_l2) ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_SRC_STRIDE_3_LOW_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_SRC_STRIDE_3_LOW_OFFSET))
 #define IDMA_REPS_3_LOW_ADDR(is_l1_to_l2)    ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_REPS_3_LOW_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_REPS_3_LOW_OFFSET))
+#define IDMA_CHAIN_HEAD_ADDR(is_l1_to_l2)    ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_CHAIN_HEAD_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_CHAIN_HEAD_OFFSET))
+#define IDMA_CHAIN_STATUS_ADDR(is_l1_to_l2)  ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_CHAIN_STATUS_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_CHAIN_STATUS_OFFSET))
+#define IDMA_CHAIN_LAST_ID_ADDR(is_l1_to_l2) ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_CHAIN_LAST_ID_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_CHAIN_LAST_ID_OFFSET))
+#define IDMA_COALESCE_COUNT_ADDR(is_l1_to_l2)   ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_COALESCE_COUNT_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_COALESCE_COUNT_OFFSET))
+#define IDMA_COALESCE_TIMEOUT_ADDR(is_l1_to_l2) ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_COALESCE_TIMEOUT_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_COALESCE_TIMEOUT_OFFSET))
+#define IDMA_XFORM_MODE_ADDR(is_l1_to_l2)       ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_XFORM_MODE_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_XFORM_MODE_OFFSET))
+#define IDMA_XFORM_ARG_ADDR(is_l1_to_l2)        ((is_l1_to_l2) ? (IDMA_MM_BASE_OBI2AXI + IDMA_XFORM_ARG_OFFSET) : (IDMA_MM_BASE_AXI2OBI + IDMA_XFORM_ARG_OFFSET))
 
 // Configuration Register Bit Fields
 #define IDMA_CONF_DECOUPLE_AW_BIT    (0)
@@ -79,6 +95,14 @@
 // Status Register Bit Fields
 #define IDMA_STATUS_BUSY_MASK        (0x3FF) // bits 9:0
 
+// Stream IDs: the register map has room for 16, iDMA_NumStreams in magia_tile_pkg.sv sets the implemented ones.
+// Each direction has a single stream (one back-end): its jobs retire in issue order.
+#define IDMA_MAX_STREAMS             (16)
+#define IDMA_NUM_STREAMS             (1)
+
+// Jobs per direction issued and not yet retired before NEXT_ID stalls (iDMA_MaxOutstanding in magia_tile_pkg.sv)
+#define IDMA_MAX_OUTSTANDING         (4)
+
 // Transfer Direction Constants
 #define IDMA_DIR_L2_TO_L1 (0)  // AXI2OBI direction
 #define IDMA_DIR_L1_TO_L2 (1)  // OBI2AXI direction
@@ -102,15 +126,67 @@ typedef unsigned int dma_ext_t;
 
 // Configuration macros
 #define IDMA_DEFAULT_CONFIG 0x0
+#define IDMA_CONF_DEFAULT   (0x3 << IDMA_CONF_ENABLE_ND_SHIFT) // Both ND dimensions enabled, all other fields 0
+
+//=============================================================================
+// Shadow Registers
+//=============================================================================
+// The job registers of each direction keep their value across submissions, so
+// the last programmed values are mirrored in SW and unchanged fields are not
+// rewritten. Define IDMA_MM_NO_SHADOW to always write every field.
+// The mirror is per tile (each tile has its own iDMA), in the tile-private
+// state of magia_tile_utils.h: a single-cycle access, zeroed at boot.
+
+typedef enum {
+  IDMA_SH_CONF = 0,
+  IDMA_SH_DST_ADDR,
+  IDMA_SH_SRC_ADDR,
+  IDMA_SH_LENGTH,
+  IDMA_SH_DST_STRIDE_2,
+  IDMA_SH_SRC_STRIDE_2,
+  IDMA_SH_REPS_2,
+  IDMA_SH_DST_STRIDE_3,
+  IDMA_SH_SRC_STRIDE_3,
+  IDMA_SH_REPS_3,
+  IDMA_SH_NUM_FIELDS
+} idma_mm_shadow_field_t;
+
+typedef struct {
+  uint32_t valid;                     // One bit per field holding a known value
+  uint32_t val[IDMA_SH_NUM_FIELDS];
+} idma_mm_shadow_t;
+
+typedef struct {
+  uint32_t         conf_val[2];       // Default configuration of each direction, 0 for IDMA_CONF_DEFAULT
+  idma_mm_shadow_t shadow[2];
+} idma_mm_tile_state_t;               // 96 B, fits the TILE_PRIV_IDMA slot
+
+#define idma_mm_state ((idma_mm_tile_state_t *)TILE_PRIV_IDMA)
+
+// Must be called if the iDMA is cleared or programmed bypassing these helpers
+static inline void idma_mm_shadow_invalidate(uint32_t is_l1_to_l2) {
+  idma_mm_state->shadow[is_l1_to_l2 ? 1 : 0].valid = 0;
+}
+
+static inline void idma_mm_write_field(uint32_t is_l1_to_l2, idma_mm_shadow_field_t field, uint32_t addr, uint32_t val) {
+#ifndef IDMA_MM_NO_SHADOW
+  idma_mm_shadow_t *sh = &idma_mm_state->shadow[is_l1_to_l2 ? 1 : 0];
+  if ((sh->valid & (1 << field)) && (sh->val[field] == val))
+    return;
+  sh->val[field] = val;
+  sh->valid     |= (1 << field);
+#endif
+  mmio32(addr) = val;
+}
 
 //=============================================================================
 // Low-Level Register Access Functions
 //=============================================================================
 
-static inline void idma_mm_conf_dir(uint32_t is_l1_to_l2, uint32_t decouple_aw, uint32_t decouple_rw,
-                                    uint32_t src_reduce_len, uint32_t dst_reduce_len,
-                                    uint32_t src_max_llen, uint32_t dst_max_llen,
-                                    uint32_t enable_nd) {
+static inline uint32_t idma_mm_conf_pack(uint32_t decouple_aw, uint32_t decouple_rw,
+                                         uint32_t src_reduce_len, uint32_t dst_reduce_len,
+                                         uint32_t src_max_llen, uint32_t dst_max_llen,
+                                         uint32_t enable_nd) {
     uint32_t conf_val = 0;
     
     if (decouple_aw) conf_val |= (1 << IDMA_CONF_DECOUPLE_AW_BIT);
@@ -122,68 +198,142 @@ static inline void idma_mm_conf_dir(uint32_t is_l1_to_l2, uint32_t decouple_aw,
     conf_val |= ((dst_max_llen & 0x7) << IDMA_CONF_DST_MAX_LLEN_SHIFT);
     conf_val |= ((enable_nd & 0x3) << IDMA_CONF_ENABLE_ND_SHIFT);
     
-    mmio32(IDMA_CONF_ADDR(is_l1_to_l2)) = conf_val;
+    return conf_val;
+}
+
+static inline void idma_mm_conf_dir(uint32_t is_l1_to_l2, uint32_t decouple_aw, uint32_t decouple_rw,
+                                    uint32_t src_reduce_len, uint32_t dst_reduce_len,
+                                    uint32_t src_max_llen, uint32_t dst_max_llen,
+                                    uint32_t enable_nd) {
+    uint32_t conf_val = idma_mm_conf_pack(decouple_aw, decouple_rw, src_reduce_len, dst_reduce_len,
+                                          src_max_llen, dst_max_llen, enable_nd);
+    
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_CONF, IDMA_CONF_ADDR(is_l1_to_l2), conf_val);
+}
+
+// Configuration programmed by every submission of a direction, IDMA_CONF_DEFAULT unless changed.
+// Per tile (idma_mm_state); the ND enable bits are forced on, as the helpers rely on them for
+// 2D/3D jobs, so a stored 0 can only mean "not changed".
+static inline void idma_mm_set_default_conf_dir(uint32_t is_l1_to_l2, uint32_t conf_val) {
+    idma_mm_state->conf_val[is_l1_to_l2 ? 1 : 0] = conf_val | IDMA_CONF_ENABLE_ND_MASK;
+}
+
+static inline uint32_t idma_mm_get_default_conf_dir(uint32_t is_l1_to_l2) {
+    uint32_t conf_val = idma_mm_state->conf_val[is_l1_to_l2 ? 1 : 0];
+    return conf_val ? conf_val : IDMA_CONF_DEFAULT;
 }
 
 static inline void idma_mm_conf_default_dir(uint32_t is_l1_to_l2) {
-    idma_mm_conf_dir(is_l1_to_l2, 0, 0, 0, 0, 0, 0, 3);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_CONF, IDMA_CONF_ADDR(is_l1_to_l2), idma_mm_get_default_conf_dir(is_l1_to_l2));
 }
 
 static inline uint32_t idma_mm_is_busy_dir(uint32_t is_l1_to_l2, uint32_t channel_id) {
-    if (channel_id >= 16) return 0;
+    if (channel_id >= IDMA_MAX_STREAMS) return 0;
     uint32_t status = mmio32(IDMA_STATUS_ADDR(is_l1_to_l2, channel_id));
     return (status & IDMA_STATUS_BUSY_MASK) ? 1 : 0;
 }
 
 static inline uint32_t idma_mm_start_transfer_dir(uint32_t is_l1_to_l2, uint32_t channel_id) {
-    if (channel_id >= 16) return 0;
+    if (channel_id >= IDMA_MAX_STREAMS) return 0;
     uint32_t transfer_id = mmio32(IDMA_NEXT_ID_ADDR(is_l1_to_l2, channel_id));
     return transfer_id;
 }
 
 static inline uint32_t idma_mm_get_done_id_dir(uint32_t is_l1_to_l2, uint32_t channel_id) {
-    if (channel_id >= 16) return 0;
+    if (channel_id >= IDMA_MAX_STREAMS) return 0;
     return mmio32(IDMA_DONE_ID_ADDR(is_l1_to_l2, channel_id));
 }
 
 static inline void idma_mm_set_addr_len_dir(uint32_t is_l1_to_l2, uint32_t dst_addr, uint32_t src_addr, uint32_t length) {
-    mmio32(IDMA_DST_ADDR_LOW_ADDR(is_l1_to_l2)) = dst_addr;
-    mmio32(IDMA_SRC_ADDR_LOW_ADDR(is_l1_to_l2)) = src_addr;
-    mmio32(IDMA_LENGTH_LOW_ADDR(is_l1_to_l2)) = length;
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_DST_ADDR, IDMA_DST_ADDR_LOW_ADDR(is_l1_to_l2), dst_addr);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_SRC_ADDR, IDMA_SRC_ADDR_LOW_ADDR(is_l1_to_l2), src_addr);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_LENGTH,   IDMA_LENGTH_LOW_ADDR(is_l1_to_l2),   length);
 }
 
 static inline void idma_mm_set_2d_params_dir(uint32_t is_l1_to_l2, uint32_t dst_stride_2, uint32_t src_stride_2, uint32_t reps_2) {
-    mmio32(IDMA_DST_STRIDE_2_LOW_ADDR(is_l1_to_l2)) = dst_stride_2;
-    mmio32(IDMA_SRC_STRIDE_2_LOW_ADDR(is_l1_to_l2)) = src_stride_2;
-    mmio32(IDMA_REPS_2_LOW_ADDR(is_l1_to_l2)) = reps_2;
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_DST_STRIDE_2, IDMA_DST_STRIDE_2_LOW_ADDR(is_l1_to_l2), dst_stride_2);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_SRC_STRIDE_2, IDMA_SRC_STRIDE_2_LOW_ADDR(is_l1_to_l2), src_stride_2);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_REPS_2,       IDMA_REPS_2_LOW_ADDR(is_l1_to_l2),       reps_2);
 }
 
 static inline void idma_mm_set_3d_params_dir(uint32_t is_l1_to_l2, uint32_t dst_stride_3, uint32_t src_stride_3, uint32_t reps_3) {
-    mmio32(IDMA_DST_STRIDE_3_LOW_ADDR(is_l1_to_l2)) = dst_stride_3;
-    mmio32(IDMA_SRC_STRIDE_3_LOW_ADDR(is_l1_to_l2)) = src_stride_3;
-    mmio32(IDMA_REPS_3_LOW_ADDR(is_l1_to_l2)) = reps_3;
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_DST_STRIDE_3, IDMA_DST_STRIDE_3_LOW_ADDR(is_l1_to_l2), dst_stride_3);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_SRC_STRIDE_3, IDMA_SRC_STRIDE_3_LOW_ADDR(is_l1_to_l2), src_stride_3);
+    idma_mm_write_field(is_l1_to_l2, IDMA_SH_REPS_3,       IDMA_REPS_3_LOW_ADDR(is_l1_to_l2),       reps_3);
 }
 
-static inline uint32_t idma_mm_wait_for_completion(uint32_t direction, uint32_t transfer_id) {
-    if (transfer_id == 0) return 0;
-    
+// Programs a full 3D job and issues it on the given stream, returns its transfer ID
+static inline uint32_t idma_mm_submit_dir(uint32_t is_l1_to_l2, uint32_t stream,
+                                          uint32_t dst_addr, uint32_t src_addr, uint32_t length,
+                                          uint32_t dst_stride_2, uint32_t src_stride_2, uint32_t reps_2,
+                                          uint32_t dst_stride_3, uint32_t src_stride_3, uint32_t reps_3) {
+    idma_mm_conf_default_dir(is_l1_to_l2);
+    idma_mm_set_addr_len_dir(is_l1_to_l2, dst_addr, src_addr, length);
+    idma_mm_set_2d_params_dir(is_l1_to_l2, dst_stride_2, src_stride_2, reps_2);
+    idma_mm_set_3d_params_dir(is_l1_to_l2, dst_stride_3, src_stride_3, reps_3);
+    return idma_mm_start_transfer_dir(is_l1_to_l2, stream);
+}
+
+// Shape shared by all the jobs of a batch: only the addresses change per job
+typedef struct {
+  uint32_t length;
+  uint32_t dst_stride_2;
+  uint32_t src_stride_2;
+  uint32_t reps_2;
+  uint32_t dst_stride_3;
+  uint32_t src_stride_3;
+  uint32_t reps_3;
+} idma_shape_t;
+
+typedef struct {
+  uint32_t src;
+  uint32_t dst;
+} idma_desc_t;
+
+// Issues num_descs jobs of the same shape back to back, returns the ID of the last one.
+// With the shadow registers each job costs two address stores and the NEXT_ID read.
+static inline uint32_t idma_mm_submit_batch_dir(uint32_t is_l1_to_l2, uint32_t stream, const idma_shape_t *shape,
+                                                const idma_desc_t *descs, uint32_t num_descs) {
+  uint32_t id = 0;
+
+  idma_mm_conf_default_dir(is_l1_to_l2);
+  idma_mm_set_2d_params_dir(is_l1_to_l2, shape->dst_stride_2, shape->src_stride_2, shape->reps_2);
+  idma_mm_set_3d_params_dir(is_l1_to_l2, shape->dst_stride_3, shape->src_stride_3, shape->reps_3);
+
+  for (uint32_t i = 0; i < num_descs; i++) {
+    idma_mm_set_addr_len_dir(is_l1_to_l2, descs[i].dst, descs[i].src, shape->length);
+    id = idma_mm_start_transfer_dir(is_l1_to_l2, stream);
+  }
+
+  return id;
+}
+
+// IDs are issued and retired in order on each stream: wrap-safe check against the done ID
+static inline uint32_t idma_mm_id_retired_dir(uint32_t is_l1_to_l2, uint32_t stream, uint32_t transfer_id) {
+    return (int32_t)(idma_mm_get_done_id_dir(is_l1_to_l2, stream) - transfer_id) >= 0;
+}
+
+// Polls of idma_mm_wait_for_completion before it gives up
+#ifndef IDMA_WAIT_MAX_POLLS
+#define IDMA_WAIT_MAX_POLLS (1000000)
+#endif
+
+// Waits until transfer_id has retired on (direction, stream), however many jobs were issued
+// after it. Returns 1 once retired (at once for ID 0: no job), 0 on timeout.
+static inline uint32_t idma_mm_wait_for_completion(uint32_t direction, uint32_t stream, uint32_t transfer_id) {
     uint32_t is_l1_to_l2 = (direction == IDMA_DIR_L1_TO_L2) ? 1 : 0;
-    uint32_t channel_id = 0;
-    uint32_t timeout = 1000000;
-    
-    while (timeout-- > 0) {
-        uint32_t is_busy = idma_mm_is_busy_dir(is_l1_to_l2, channel_id);
-        
-        if (!is_busy) {
-            uint32_t done_id = idma_mm_get_done_id_dir(is_l1_to_l2, channel_id);
-            if (done_id == transfer_id) {
-                return 1;
-            }
-        }
-        
+
+    if (transfer_id == 0)
+        return 1;
+
+    for (uint32_t polls = 0; polls < IDMA_WAIT_MAX_POLLS; polls++) {
+        if (idma_mm_id_retired_dir(is_l1_to_l2, stream, transfer_id))
+            return 1;
         wait_nop(10);
     }
-    
+
+    printf("iDMA: job %0d (dir %0d, stream %0d) not retired after %0d polls\n",
+           transfer_id, is_l1_to_l2, stream, IDMA_WAIT_MAX_POLLS);
     return 0;
 }
 
@@ -192,28 +342,28 @@ static inline uint32_t idma_mm_wait_for_completion(uint32_t direction, uint32_t
 //=============================================================================
 
 // Forward declarations
-static inline int idma_L1ToL2(unsigned int src, unsigned int dst, unsigned short size);
-static inline int idma_L2ToL1(unsigned int src, unsigned int dst, unsigned short size);
-static inline int idma_L1ToL1(unsigned int src, unsigned int dst, unsigned short size);
-static inline int idma_L1ToL2_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L1ToL2(unsigned int src, unsigned int dst, unsigned int size);
+static inline int idma_L2ToL1(unsigned int src, unsigned int dst, unsigned int size);
+static inline int idma_L1ToL1(unsigned int src, unsigned int dst, unsigned int size);
+static inline int idma_L1ToL2_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps);
-static inline int idma_L2ToL1_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L2ToL1_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps);
-static inline int idma_L1ToL1_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L1ToL1_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps);
 
-static inline int dma_memcpy(dma_ext_t ext, unsigned int loc, unsigned short size, int ext2loc) {
+static inline int dma_memcpy(dma_ext_t ext, unsigned int loc, unsigned int size, int ext2loc) {
   if (ext2loc)
     return idma_L2ToL1(ext, loc, size);
   else
     return idma_L1ToL2(loc, ext, size);
 }
 
-static inline int dma_l1ToExt(dma_ext_t ext, unsigned int loc, unsigned short size) {
+static inline int dma_l1ToExt(dma_ext_t ext, unsigned int loc, unsigned int size) {
   return idma_L1ToL2(loc, ext, size);
 }
 
-static inline int dma_extToL1(unsigned int loc, dma_ext_t ext, unsigned short size) {
+static inline int dma_extToL1(unsigned int loc, dma_ext_t ext, unsigned int size) {
   return idma_L2ToL1(ext, loc, size);
 }
 
@@ -229,28 +379,16 @@ static inline int idma_memcpy(unsigned int src, unsigned int dst, unsigned int s
   return 0;
 }
 
-static inline int idma_L1ToL2(unsigned int src, unsigned int dst, unsigned short size) {
-  idma_mm_conf_default_dir(1);
-  idma_mm_set_addr_len_dir(1, dst, src, size);
-  idma_mm_set_2d_params_dir(1, 0, 0, 1);
-  idma_mm_set_3d_params_dir(1, 0, 0, 1);
-  return idma_mm_start_transfer_dir(1, 0);
+static inline int idma_L1ToL2(unsigned int src, unsigned int dst, unsigned int size) {
+  return idma_mm_submit_dir(1, 0, dst, src, size, 0, 0, 1, 0, 0, 1);
 }
 
-static inline int idma_L2ToL1(unsigned int src, unsigned int dst, unsigned short size) {
-  idma_mm_conf_default_dir(0);
-  idma_mm_set_addr_len_dir(0, dst, src, size);
-  idma_mm_set_2d_params_dir(0, 0, 0, 1);
-  idma_mm_set_3d_params_dir(0, 0, 0, 1);
-  return idma_mm_start_transfer_dir(0, 0);
+static inline int idma_L2ToL1(unsigned int src, unsigned int dst, unsigned int size) {
+  return idma_mm_submit_dir(0, 0, dst, src, size, 0, 0, 1, 0, 0, 1);
 }
 
-static inline int idma_L1ToL1(unsigned int src, unsigned int dst, unsigned short size) {
-  idma_mm_conf_default_dir(0);
-  idma_mm_set_addr_len_dir(0, dst, src, size);
-  idma_mm_set_2d_params_dir(0, 0, 0, 1);
-  idma_mm_set_3d_params_dir(0, 0, 0, 1);
-  return idma_mm_start_transfer_dir(0, 0);
+static inline int idma_L1ToL1(unsigned int src, unsigned int dst, unsigned int size) {
+  return idma_mm_submit_dir(0, 0, dst, src, size, 0, 0, 1, 0, 0, 1);
 }
 
 //=============================================================================
@@ -270,31 +408,339 @@ static inline int idma_memcpy_2d(unsigned int src, unsigned int dst, unsigned in
   return 0;
 }
 
-static inline int idma_L1ToL2_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L1ToL2_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps) {
-  idma_mm_conf_default_dir(1);
-  idma_mm_set_addr_len_dir(1, dst, src, size);
-  idma_mm_set_2d_params_dir(1, dst_stride, src_stride, num_reps);
-  idma_mm_set_3d_params_dir(1, 0, 0, 1);
-  return idma_mm_start_transfer_dir(1, 0);
+  return idma_mm_submit_dir(1, 0, dst, src, size, dst_stride, src_stride, num_reps, 0, 0, 1);
 }
 
-static inline int idma_L2ToL1_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L2ToL1_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps) {
-  idma_mm_conf_default_dir(0);
-  idma_mm_set_addr_len_dir(0, dst, src, size);
-  idma_mm_set_2d_params_dir(0, dst_stride, src_stride, num_reps);
-  idma_mm_set_3d_params_dir(0, 0, 0, 1);
-  return idma_mm_start_transfer_dir(0, 0);
+  return idma_mm_submit_dir(0, 0, dst, src, size, dst_stride, src_stride, num_reps, 0, 0, 1);
 }
 
-static inline int idma_L1ToL1_2d(unsigned int src, unsigned int dst, unsigned short size,
+static inline int idma_L1ToL1_2d(unsigned int src, unsigned int dst, unsigned int size,
                                  unsigned int src_stride, unsigned int dst_stride, unsigned int num_reps) {
-  idma_mm_conf_default_dir(0);
-  idma_mm_set_addr_len_dir(0, dst, src, size);
-  idma_mm_set_2d_params_dir(0, dst_stride, src_stride, num_reps);
-  idma_mm_set_3d_params_dir(0, 0, 0, 1);
-  return idma_mm_start_transfer_dir(0, 0);
+  return idma_mm_submit_dir(0, 0, dst, src, size, dst_stride, src_stride, num_reps, 0, 0, 1);
+}
+
+//=============================================================================
+// High-Level DMA API - Large Transfers
+//=============================================================================
+// The iDMA length is 32-bit (iDMA_TFLenWidth). A large copy is issued as a 2D job
+// of contiguous IDMA_LARGE_ROW_LEN rows followed by a 1D job for the tail: both fit
+// the job FIFO of the channel, so the tail is queued while the rows are moving and
+// the engine never idles between them. Jobs retire in order, the returned ID is the
+// last one issued.
+
+#define IDMA_LARGE_ROW_LEN (0x10000) // 64 KiB rows
+
+static inline int idma_memcpy_large_stream(uint32_t is_l1_to_l2, uint32_t stream, uint32_t src, uint32_t dst, uint32_t len) {
+  uint32_t rows = len / IDMA_LARGE_ROW_LEN;
+  uint32_t tail = len % IDMA_LARGE_ROW_LEN;
+  int      id   = 0;
+
+  if (rows > 1) {
+    id = idma_mm_submit_dir(is_l1_to_l2, stream, dst, src, IDMA_LARGE_ROW_LEN,
+                            IDMA_LARGE_ROW_LEN, IDMA_LARGE_ROW_LEN, rows, 0, 0, 1);
+  } else {
+    // A single row is folded into the 1D job
+    tail += rows * IDMA_LARGE_ROW_LEN;
+    rows  = 0;
+  }
+
+  if (tail) {
+    uint32_t offset = rows * IDMA_LARGE_ROW_LEN;
+    id = idma_mm_submit_dir(is_l1_to_l2, stream, dst + offset, src + offset, tail, 0, 0, 1, 0, 0, 1);
+  }
+
+  return id;
+}
+
+static inline int idma_memcpy_large_dir(uint32_t is_l1_to_l2, uint32_t src, uint32_t dst, uint32_t len) {
+  return idma_memcpy_large_stream(is_l1_to_l2, 0, src, dst, len);
+}
+
+static inline int idma_L2ToL1_large(uint32_t src, uint32_t dst, uint32_t len) {
+  return idma_memcpy_large_dir(0, src, dst, len);
+}
+
+static inline int idma_L1ToL2_large(uint32_t src, uint32_t dst, uint32_t len) {
+  return idma_memcpy_large_dir(1, src, dst, len);
+}
+
+static inline int idma_L1ToL1_large(uint32_t src, uint32_t dst, uint32_t len) {
+  return idma_memcpy_large_dir(0, src, dst, len);
+}
+
+//=============================================================================
+// Independent DMA Streams
+//=============================================================================
+// A queue tracks the last ID it issued on a direction, so waiting on it only depends on
+// that direction: a prefetch queue on AXI2OBI and a write-back queue on OBI2AXI progress
+// without blocking each other. The iDMA has one stream per direction (IDMA_NUM_STREAMS):
+// use one queue per direction, as a second one would wait behind the jobs of the first.
+
+typedef struct {
+  uint32_t is_l1_to_l2; // Direction: 0 = AXI2OBI (L2/L1 to L1), 1 = OBI2AXI (L1 to L2)
+  uint32_t stream;      // Hardware stream ID, below IDMA_NUM_STREAMS (0 on this iDMA)
+  uint32_t last_id;     // Last transfer ID issued, 0 if none
+} idma_queue_t;
+
+#define IDMA_QUEUE_OK         (0)
+#define IDMA_QUEUE_BAD_STREAM (-1)  // Stream ID not implemented by the iDMA
+
+// Returns IDMA_QUEUE_BAD_STREAM, leaving q untouched, if stream >= IDMA_NUM_STREAMS
+static inline int idma_queue_init(idma_queue_t *q, uint32_t is_l1_to_l2, uint32_t stream) {
+  if (stream >= IDMA_NUM_STREAMS)
+    return IDMA_QUEUE_BAD_STREAM;
+  q->is_l1_to_l2 = is_l1_to_l2;
+  q->stream      = stream;
+  q->last_id     = 0;
+  return IDMA_QUEUE_OK;
+}
+
+static inline uint32_t idma_queue_memcpy(idma_queue_t *q, uint32_t src, uint32_t dst, uint32_t len) {
+  uint32_t id = idma_memcpy_large_stream(q->is_l1_to_l2, q->stream, src, dst, len);
+  if (id)
+    q->last_id = id;
+  return id;
+}
+
+static inline uint32_t idma_queue_memcpy_2d(idma_queue_t *q, uint32_t src, uint32_t dst, uint32_t len,
+                                            uint32_t src_stride, uint32_t dst_stride, uint32_t num_reps) {
+  uint32_t id = idma_mm_submit_dir(q->is_l1_to_l2, q->stream, dst, src, len,
+                                   dst_stride, src_stride, num_reps, 0, 0, 1);
+  if (id)
+    q->last_id = id;
+  return id;
+}
+
+static inline uint32_t idma_queue_id_done(idma_queue_t *q, uint32_t transfer_id) {
+  return idma_mm_id_retired_dir(q->is_l1_to_l2, q->stream, transfer_id);
+}
+
+static inline uint32_t idma_queue_is_done(idma_queue_t *q) {
+  return (q->last_id == 0) || idma_queue_id_done(q, q->last_id);
+}
+
+static inline void idma_queue_wait_id(idma_queue_t *q, uint32_t transfer_id) {
+  while (!idma_queue_id_done(q, transfer_id)) {
+    wait_nop(1);
+  }
+}
+
+static inline void idma_queue_wait(idma_queue_t *q) {
+  if (q->last_id)
+    idma_queue_wait_id(q, q->last_id);
+}
+
+//=============================================================================
+// Descriptor Chains
+//=============================================================================
+// A chain is a linked list of job descriptors in memory (L1, or L2 program data).
+// Writing the first one to CHAIN_HEAD hands the whole list to the walker of that
+// direction, which programs and launches every job as idma_mm_submit_dir would:
+// the core is free until the chain event (EU_IDMA_*_CHAIN) or a fence fires.
+// The job registers of that direction must not be written while the chain runs.
+
+#define IDMA_CHAIN_CTRL_CONF_MASK (0xFFF)      // IDMA_CONF value of the job
+#define IDMA_CHAIN_CTRL_GATHER    (1u << 30)   // Indexed gather, see idma_chain_desc_gather
+#define IDMA_CHAIN_CTRL_FENCE     (1u << 31)   // Wait for the job to retire and raise the chain event
+
+typedef struct {
+  uint32_t next;          // Address of the next descriptor, 0 ends the chain
+  uint32_t ctrl;          // IDMA_CHAIN_CTRL_*
+  uint32_t dst_addr;
+  uint32_t src_addr;
+  uint32_t length;
+  uint32_t dst_stride_2;
+  uint32_t src_stride_2;
+  uint32_t reps_2;
+  uint32_t dst_stride_3;
+  uint32_t src_stride_3;
+  uint32_t reps_3;
+} __attribute__((aligned(4))) idma_chain_desc_t;
+
+static inline void idma_chain_desc_1d(idma_chain_desc_t *d, uint32_t dst, uint32_t src, uint32_t len) {
+  d->next         = 0;
+  d->ctrl         = IDMA_CONF_DEFAULT;
+  d->dst_addr     = dst;
+  d->src_addr     = src;
+  d->length       = len;
+  d->dst_stride_2 = 0;
+  d->src_stride_2 = 0;
+  d->reps_2       = 1;
+  d->dst_stride_3 = 0;
+  d->src_stride_3 = 0;
+  d->reps_3       = 1;
+}
+
+static inline void idma_chain_desc_2d(idma_chain_desc_t *d, uint32_t dst, uint32_t src, uint32_t len,
+                                      uint32_t dst_stride, uint32_t src_stride, uint32_t reps) {
+  idma_chain_desc_1d(d, dst, src, len);
+  d->dst_stride_2 = dst_stride;
+  d->src_stride_2 = src_stride;
+  d->reps_2       = reps;
+}
+
+// Gathers num_rows rows of row_len bytes into dst, one after the other: row i is read
+// at src + idx[i], idx being an array of byte offsets in L1. One job per row.
+static inline void idma_chain_desc_gather(idma_chain_desc_t *d, uint32_t dst, uint32_t src, uint32_t row_len,
+                                          const uint32_t *idx, uint32_t num_rows) {
+  idma_chain_desc_1d(d, dst, src, row_len);
+  d->ctrl        |= IDMA_CHAIN_CTRL_GATHER;
+  d->dst_stride_2 = (uint32_t)idx;
+  d->reps_2       = num_rows;
+}
+
+static inline void idma_chain_desc_fence(idma_chain_desc_t *d) {
+  d->ctrl |= IDMA_CHAIN_CTRL_FENCE;
+}
+
+// Links descs[0..num-1] in order and terminates the list
+static inline void idma_chain_link(idma_chain_desc_t *descs, uint32_t num) {
+  for (uint32_t i = 0; i < num; i++)
+    descs[i].next = (i + 1 < num) ? (uint32_t)&descs[i + 1] : 0;
+}
+
+static inline uint32_t idma_chain_busy(uint32_t is_l1_to_l2) {
+  return mmio32(IDMA_CHAIN_STATUS_ADDR(is_l1_to_l2)) & 0x1;
+}
+
+static inline uint32_t idma_chain_last_id(uint32_t is_l1_to_l2) {
+  return mmio32(IDMA_CHAIN_LAST_ID_ADDR(is_l1_to_l2));
+}
+
+// Returns 0 if a chain is already running on that direction
+static inline uint32_t idma_chain_start(uint32_t is_l1_to_l2, const idma_chain_desc_t *head) {
+  if (idma_chain_busy(is_l1_to_l2))
+    return 0;
+  // The walker leaves its own values in the job registers
+  idma_mm_shadow_invalidate(is_l1_to_l2);
+  mmio32(IDMA_CHAIN_HEAD_ADDR(is_l1_to_l2)) = (uint32_t)head;
+  return 1;
+}
+
+static inline void idma_chain_wait(uint32_t is_l1_to_l2) {
+  while (idma_chain_busy(is_l1_to_l2)) {
+    wait_nop(1);
+  }
+}
+
+// Starts a single gather from L2 (embedding or KV-cache rows) on the L2_TO_L1 direction.
+// d must stay valid until the chain event (EU_IDMA_A2O_CHAIN) fires at the end of the gather.
+static inline uint32_t idma_gather_L2ToL1(idma_chain_desc_t *d, uint32_t dst, uint32_t src, uint32_t row_len,
+                                          const uint32_t *idx, uint32_t num_rows) {
+  idma_chain_desc_gather(d, dst, src, row_len, idx, num_rows);
+  idma_chain_desc_fence(d);
+  return idma_chain_start(IDMA_DIR_L2_TO_L1, d);
+}
+
+//=============================================================================
+// L1 Data Transforms
+//=============================================================================
+// Each direction can transform the data on its L1 side while it moves (idma_obi_xform.sv):
+// fill for memset, FP32 to FP16/FP8 on the way into L1, FP16/FP8 to FP32 on the way out.
+// The mode applies to every job of the direction until it is reset, so it is only
+// changed with the direction idle. FP8 is E5M2; conversions round to nearest even,
+// saturate to infinity and flush subnormals to zero.
+
+#define IDMA_XFORM_NONE       (0)
+#define IDMA_XFORM_FILL       (1)  // Both directions: data replaced by the 32-bit pattern
+#define IDMA_XFORM_FP32_FP16  (2)  // L2_TO_L1 only
+#define IDMA_XFORM_FP32_FP8   (3)  // L2_TO_L1 only
+#define IDMA_XFORM_FP16_FP32  (4)  // L1_TO_L2 only
+#define IDMA_XFORM_FP8_FP32   (5)  // L1_TO_L2 only
+
+// Rows of the fill source: the data read is dropped, a 2D job with source stride 0
+// keeps the reads in one IDMA_FILL_ROW window of program data
+#define IDMA_FILL_ROW (0x400)
+
+static inline void idma_mm_wait_idle_dir(uint32_t is_l1_to_l2) {
+  while (idma_mm_is_busy_dir(is_l1_to_l2, 0)) {
+    wait_nop(1);
+  }
+}
+
+static inline void idma_mm_set_xform_dir(uint32_t is_l1_to_l2, uint32_t mode, uint32_t arg) {
+  mmio32(IDMA_XFORM_ARG_ADDR(is_l1_to_l2))  = arg;
+  mmio32(IDMA_XFORM_MODE_ADDR(is_l1_to_l2)) = mode;
+}
+
+// Submits the jobs of a fill of len bytes at dst, reading the IDMA_FILL_ROW window at src.
+// The FILL mode must already be set on the direction. Returns the ID of the last job.
+static inline uint32_t idma_fill_submit_dir(uint32_t is_l1_to_l2, uint32_t dst, uint32_t src, uint32_t len) {
+  uint32_t rows = len / IDMA_FILL_ROW, tail = len % IDMA_FILL_ROW;
+  uint32_t id = 0;
+
+  if (rows)
+    id = idma_mm_submit_dir(is_l1_to_l2, 0, dst, src, IDMA_FILL_ROW,
+                            IDMA_FILL_ROW, 0, rows, 0, 0, 1);
+  if (tail)
+    id = idma_mm_submit_dir(is_l1_to_l2, 0, dst + rows*IDMA_FILL_ROW, src, tail,
+                            0, 0, 1, 0, 0, 1);
+  return id;
+}
+
+// Fills len bytes of L1 at dst (word-aligned, len multiple of 4) with pattern. Blocking.
+static inline void idma_memset_l1(uint32_t dst, uint32_t pattern, uint32_t len) {
+  uint32_t id;
+
+  idma_mm_wait_idle_dir(IDMA_DIR_L2_TO_L1);
+  idma_mm_set_xform_dir(IDMA_DIR_L2_TO_L1, IDMA_XFORM_FILL, pattern);
+  id = idma_fill_submit_dir(IDMA_DIR_L2_TO_L1, dst, L2_BASE, len);
+  if (id)
+    idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, id);
+  idma_mm_set_xform_dir(IDMA_DIR_L2_TO_L1, IDMA_XFORM_NONE, 0);
+}
+
+// Moves num FP32 values from L2 to L1, packed as FP16 (or FP8) at dst. Blocking.
+static inline void idma_L2ToL1_fp32_narrow(uint32_t src, uint32_t dst, uint32_t num, uint32_t mode) {
+  idma_mm_wait_idle_dir(IDMA_DIR_L2_TO_L1);
+  idma_mm_set_xform_dir(IDMA_DIR_L2_TO_L1, mode, dst);
+  idma_mm_wait_for_completion(IDMA_DIR_L2_TO_L1, 0, idma_L2ToL1_large(src, dst, 4*num));
+  idma_mm_set_xform_dir(IDMA_DIR_L2_TO_L1, IDMA_XFORM_NONE, 0);
+}
+
+// Moves num FP16 (or FP8) values packed at src in L1 to L2 as FP32. Blocking.
+static inline void idma_L1ToL2_fp32_widen(uint32_t src, uint32_t dst, uint32_t num, uint32_t mode) {
+  idma_mm_wait_idle_dir(IDMA_DIR_L1_TO_L2);
+  idma_mm_set_xform_dir(IDMA_DIR_L1_TO_L2, mode, src);
+  idma_mm_wait_for_completion(IDMA_DIR_L1_TO_L2, 0, idma_L1ToL2_large(src, dst, 4*num));
+  idma_mm_set_xform_dir(IDMA_DIR_L1_TO_L2, IDMA_XFORM_NONE, 0);
+}
+
+//=============================================================================
+// Zero-Copy Transfers from Program Data
+//=============================================================================
+// Initialized arrays (.data/.rodata) are linked in L2 (dataram in link.ld), so the
+// AXI side of the iDMA reads them in place: no core copy into an L2 staging area.
+// The iDMA realigns arbitrary source/destination byte offsets in HW.
+
+static inline uint32_t idma_addr_is_l2(uint32_t addr) {
+  return addr >= L2_ADDR_START;
+}
+
+static inline uint32_t idma_addr_is_stack(uint32_t addr) {
+  return (addr >= STACK_START) && (addr <= STACK_END);
+}
+
+// Moves len bytes of program data (L2, L1 or stack) to the L1 address dst.
+// Returns the ID of the last iDMA job, 0 if nothing was left to the iDMA.
+static inline int idma_data_to_l1(const void *src, uint32_t dst, uint32_t len) {
+  uint32_t src_addr = (uint32_t)src;
+
+  // The stack is not reachable from the iDMA: copy straight into dst, still without staging
+  if (idma_addr_is_stack(src_addr)) {
+    for (uint32_t i = 0; i < len; i++)
+      mmio8(dst + i) = mmio8(src_addr + i);
+    return 0;
+  }
+
+  if (idma_addr_is_l2(src_addr))
+    return idma_L2ToL1_large(src_addr, dst, len);
+  else
+    return idma_L1ToL1_large(src_addr, dst, len);
 }
 
 //=============================================================================
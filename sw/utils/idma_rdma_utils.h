@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Tile-to-Tile L1 RDMA
+ * Put/get between the L1 of the local tile and the L1 of a remote tile over the
+ * NoC, with an optional notification event raised on the destination tile
+ */
+
+#ifndef IDMA_RDMA_UTILS_H
+#define IDMA_RDMA_UTILS_H
+
+#include <stdint.h>
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+//=============================================================================
+// Addressing
+//=============================================================================
+// Tile t sees its L1 at L1_BASE + t*L1_TILE_OFFSET, the same address the other tiles
+// use to reach it over the NoC. Remote buffers are given as offsets from L1_BASE, so the
+// same symbol (e.g. X_BASE - L1_BASE) names the buffer on every tile.
+
+// Last word of each L1: a write to it from the NoC raises EU_NOC_NOTIFY on that tile (L1_NOTIFY_ADDR in magia_tile_pkg.sv)
+#define L1_NOTIFY_OFFSET (L1_SIZE - 0x3)
+// Word just below it: holds the ID of the local tile, source of the outgoing notifications
+#define L1_NOTIFY_SRC_OFFSET (L1_NOTIFY_OFFSET - 0x4)
+
+#define IDMA_RDMA_NO_SENDER (0xFFFFFFFF)
+
+static inline uint32_t idma_tile_l1_addr(uint32_t tile, uint32_t offset) {
+  return L1_BASE + tile*L1_TILE_OFFSET + offset;
+}
+
+static inline uint32_t idma_local_l1_addr(uint32_t offset) {
+  return idma_tile_l1_addr(get_hartid(), offset);
+}
+
+//=============================================================================
+// Put / Get
+//=============================================================================
+// A put reads the local L1 on the OBI side and writes the remote L1 through the AXI side
+// (OBI2AXI channel); a get reads the remote L1 through the AXI side and writes the local
+// L1 (AXI2OBI channel). The returned IDs complete on the local tile as any other job.
+
+// Copies len bytes from the local L1 address src to the offset dst of the L1 of tile
+static inline uint32_t idma_put(uint32_t tile, uint32_t dst, uint32_t src, uint32_t len) {
+  return idma_memcpy_large_dir(IDMA_DIR_L1_TO_L2, src, idma_tile_l1_addr(tile, dst), len);
+}
+
+// Copies len bytes from the offset src of the L1 of tile to the local L1 address dst
+static inline uint32_t idma_get(uint32_t tile, uint32_t dst, uint32_t src, uint32_t len) {
+  return idma_memcpy_large_dir(IDMA_DIR_L2_TO_L1, idma_tile_l1_addr(tile, src), dst, len);
+}
+
+//=============================================================================
+// Notification
+//=============================================================================
+// The notification is one more OBI2AXI job that copies the ID of the sender into the
+// notification word of the destination. Jobs leave the channel in order and follow the
+// same XY route, so it reaches the destination after the data it follows.
+
+static inline void idma_notify_init(void) {
+  mmio32(idma_local_l1_addr(L1_NOTIFY_SRC_OFFSET)) = get_hartid();
+  mmio32(idma_local_l1_addr(L1_NOTIFY_OFFSET))     = IDMA_RDMA_NO_SENDER;
+  eu_enable_events(EU_NOC_NOTIFY_MASK);
+}
+
+// Raises EU_NOC_NOTIFY on tile once the jobs issued before on OBI2AXI have landed
+static inline uint32_t idma_notify(uint32_t tile) {
+  return idma_mm_submit_dir(IDMA_DIR_L1_TO_L2, 0,
+                            idma_tile_l1_addr(tile, L1_NOTIFY_OFFSET),
+                            idma_local_l1_addr(L1_NOTIFY_SRC_OFFSET), 4,
+                            0, 0, 1, 0, 0, 1);
+}
+
+// Put followed by a notification of the destination, returns the ID of the notification
+static inline uint32_t idma_put_notify(uint32_t tile, uint32_t dst, uint32_t src, uint32_t len) {
+  idma_put(tile, dst, src, len);
+  return idma_notify(tile);
+}
+
+// Sleeps until a notification arrives, returns the ID of the last tile that notified.
+// Notifications arriving together are merged by the Event Unit: count them in the data if needed.
+static inline uint32_t idma_notify_wait(eu_wait_mode_t mode) {
+  uint32_t sender;
+
+  eu_noc_wait_notify(mode);
+
+  sender = mmio32(idma_local_l1_addr(L1_NOTIFY_OFFSET));
+  mmio32(idma_local_l1_addr(L1_NOTIFY_OFFSET)) = IDMA_RDMA_NO_SENDER;
+
+  return sender;
+}
+
+#endif // IDMA_RDMA_UTILS_H
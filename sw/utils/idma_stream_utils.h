@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Streaming Pipeline
+ * Double/triple buffering over the AXI2OBI and OBI2AXI channels: tile i+1 is
+ * prefetched and tile i-1 is drained while the user kernel works on tile i
+ */
+
+#ifndef IDMA_STREAM_UTILS_H
+#define IDMA_STREAM_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "event_unit_utils.h"
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+#define IDMA_STREAM_MAX_BUFS (3)
+
+// Kernel run on each tile: reads in_buf, writes out_buf (both in L1)
+typedef void (*idma_stream_kernel_t)(uint32_t tile_idx, uint32_t in_buf, uint32_t out_buf, void *args);
+
+typedef struct {
+  uint32_t       num_bufs;                        // 2 = double buffering, 3 = triple buffering
+  uint32_t       in_bufs[IDMA_STREAM_MAX_BUFS];   // L1 input buffers
+  uint32_t       out_bufs[IDMA_STREAM_MAX_BUFS];  // L1 output buffers
+  uint32_t       in_ids[IDMA_STREAM_MAX_BUFS];    // Last AXI2OBI ID filling each input buffer
+  uint32_t       out_ids[IDMA_STREAM_MAX_BUFS];   // Last OBI2AXI ID draining each output buffer
+  uint32_t       in_len;                          // Bytes per input tile
+  uint32_t       out_len;                         // Bytes per output tile
+  idma_queue_t   in_q;
+  idma_queue_t   out_q;
+  eu_wait_mode_t mode;
+} idma_stream_t;
+
+//=============================================================================
+// Completion
+//=============================================================================
+
+// The done event only wakes the core: the transfer ID decides, so events of other
+// jobs (or already consumed ones) cannot make the pipeline reuse a busy buffer
+static inline void idma_stream_wait_id(idma_stream_t *s, idma_queue_t *q, uint32_t transfer_id) {
+  eu_idma_wait_id(q->is_l1_to_l2, q->stream, transfer_id, s->mode);
+}
+
+//=============================================================================
+// Pipeline
+//=============================================================================
+
+static inline void idma_stream_init(idma_stream_t *s, uint32_t num_bufs,
+                                    const uint32_t *in_bufs, uint32_t in_len,
+                                    const uint32_t *out_bufs, uint32_t out_len,
+                                    eu_wait_mode_t mode) {
+  if (num_bufs < 2)                    num_bufs = 2;
+  if (num_bufs > IDMA_STREAM_MAX_BUFS) num_bufs = IDMA_STREAM_MAX_BUFS;
+
+  s->num_bufs = num_bufs;
+  s->in_len   = in_len;
+  s->out_len  = out_len;
+  s->mode     = mode;
+
+  for (uint32_t b = 0; b < num_bufs; b++) {
+    s->in_bufs[b]  = in_bufs[b];
+    s->out_bufs[b] = out_bufs[b];
+    s->in_ids[b]   = 0;
+    s->out_ids[b]  = 0;
+  }
+
+  idma_queue_init(&s->in_q,  IDMA_DIR_L2_TO_L1, 0);
+  idma_queue_init(&s->out_q, IDMA_DIR_L1_TO_L2, 0);
+
+  eu_enable_events(EU_IDMA_ALL_DONE_MASK);
+}
+
+static inline void idma_stream_prefetch(idma_stream_t *s, uint32_t src, uint32_t tile_idx) {
+  uint32_t b = tile_idx % s->num_bufs;
+  s->in_ids[b] = idma_queue_memcpy(&s->in_q, src, s->in_bufs[b], s->in_len);
+}
+
+// Streams num_tiles input tiles (src + i*src_stride) through kernel into dst + i*dst_stride
+static inline void idma_stream_run(idma_stream_t *s,
+                                   uint32_t src, uint32_t src_stride,
+                                   uint32_t dst, uint32_t dst_stride,
+                                   uint32_t num_tiles, idma_stream_kernel_t kernel, void *args) {
+  uint32_t depth = s->num_bufs - 1;  // Tiles in flight ahead of the one being computed
+
+  for (uint32_t i = 0; i < depth && i < num_tiles; i++)
+    idma_stream_prefetch(s, src + i*src_stride, i);
+
+  for (uint32_t i = 0; i < num_tiles; i++) {
+    uint32_t b = i % s->num_bufs;
+
+    // Input of tile i landed, output buffer drained from tile i-num_bufs
+    idma_stream_wait_id(s, &s->in_q,  s->in_ids[b]);
+    idma_stream_wait_id(s, &s->out_q, s->out_ids[b]);
+
+    // Refill the buffer of tile i-1, already consumed
+    if (i + depth < num_tiles)
+      idma_stream_prefetch(s, src + (i + depth)*src_stride, i + depth);
+
+    kernel(i, s->in_bufs[b], s->out_bufs[b], args);
+
+    s->out_ids[b] = idma_queue_memcpy(&s->out_q, s->out_bufs[b], dst + i*dst_stride, s->out_len);
+  }
+
+  // Drain the last write-backs
+  idma_stream_wait_id(s, &s->out_q, s->out_q.last_id);
+}
+
+#endif // IDMA_STREAM_UTILS_H
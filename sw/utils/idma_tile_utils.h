@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA iDMA Matrix Tiling Utils
+ * Sub-block extraction, transposition and zero padding of row-major matrices,
+ * expressed as 2D/3D iDMA jobs: the core never touches the data
+ */
+
+#ifndef IDMA_TILE_UTILS_H
+#define IDMA_TILE_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+// RedMulE reads H x (P+1) = 8 x 4 FP16 elements per L1 access (see DWH in magia_tile_pkg.sv)
+#define REDMULE_ELEMS_PER_ACCESS (32)
+
+// Zero source for padding, linked in .bss (L2) and cleared by crt0
+#define IDMA_ZERO_BUF_LEN (1024)
+
+static uint8_t idma_zero_buf[IDMA_ZERO_BUF_LEN] __attribute__((aligned(4)));
+
+// Row-major matrix view
+typedef struct {
+  uint32_t base;  // Address of element (0, 0)
+  uint32_t ld;    // Leading dimension: elements between the starts of two rows
+  uint32_t elem;  // Element size in bytes
+} idma_matrix_t;
+
+static inline uint32_t idma_tile_round_up(uint32_t dim, uint32_t align) {
+  return ((dim + align - 1) / align) * align;
+}
+
+static inline uint32_t idma_matrix_addr(const idma_matrix_t *m, uint32_t row, uint32_t col) {
+  return m->base + (row * m->ld + col) * m->elem;
+}
+
+//=============================================================================
+// Tiling
+//=============================================================================
+
+// Gathers the rows x cols block at (row, col) of src into dst (L1)
+static inline uint32_t idma_tile_get(const idma_matrix_t *src, uint32_t row, uint32_t col,
+                                     uint32_t rows, uint32_t cols, const idma_matrix_t *dst) {
+  return idma_mm_submit_dir(IDMA_DIR_L2_TO_L1, 0,
+                            dst->base, idma_matrix_addr(src, row, col), cols * src->elem,
+                            dst->ld * dst->elem, src->ld * src->elem, rows,
+                            0, 0, 1);
+}
+
+// Scatters the rows x cols block of src (L1) at (row, col) of dst
+static inline uint32_t idma_tile_put(const idma_matrix_t *src, const idma_matrix_t *dst,
+                                     uint32_t row, uint32_t col, uint32_t rows, uint32_t cols) {
+  return idma_mm_submit_dir(IDMA_DIR_L1_TO_L2, 0,
+                            idma_matrix_addr(dst, row, col), src->base, cols * src->elem,
+                            dst->ld * dst->elem, src->ld * src->elem, rows,
+                            0, 0, 1);
+}
+
+// Gathers the rows x cols block at (row, col) of src transposed into dst (cols x rows).
+// One element per burst: meant for small operands, e.g. W tiles of RedMulE.
+static inline uint32_t idma_tile_get_transposed(const idma_matrix_t *src, uint32_t row, uint32_t col,
+                                                uint32_t rows, uint32_t cols, const idma_matrix_t *dst) {
+  return idma_mm_submit_dir(IDMA_DIR_L2_TO_L1, 0,
+                            dst->base, idma_matrix_addr(src, row, col), src->elem,
+                            dst->ld * dst->elem, src->elem, cols,       // Along a source row
+                            dst->elem, src->ld * src->elem, rows);      // Across source rows
+}
+
+//=============================================================================
+// Padding
+//=============================================================================
+
+// Zeroes a rows x row_bytes region with dst_stride bytes between rows
+static inline uint32_t idma_tile_zero_2d(uint32_t dst, uint32_t row_bytes, uint32_t dst_stride, uint32_t rows) {
+  uint32_t id = 0;
+
+  if (rows == 0)
+    return 0;
+
+  // The zero buffer is re-read for every row (source stride 0)
+  for (uint32_t off = 0; off < row_bytes; off += IDMA_ZERO_BUF_LEN) {
+    uint32_t len = (row_bytes - off > IDMA_ZERO_BUF_LEN) ? IDMA_ZERO_BUF_LEN : row_bytes - off;
+    id = idma_mm_submit_dir(IDMA_DIR_L2_TO_L1, 0, dst + off, (uint32_t)idma_zero_buf, len,
+                            dst_stride, 0, rows, 0, 0, 1);
+  }
+
+  return id;
+}
+
+// Zeroes the part of the prows x pcols dst tile outside its top-left rows x cols block
+static inline uint32_t idma_tile_zero_pad(const idma_matrix_t *dst, uint32_t rows, uint32_t cols,
+                                          uint32_t prows, uint32_t pcols) {
+  uint32_t id = 0;
+  uint32_t pitch = dst->ld * dst->elem;
+
+  if (pcols > cols)
+    id = idma_tile_zero_2d(idma_matrix_addr(dst, 0, cols), (pcols - cols) * dst->elem, pitch, rows);
+
+  if (prows > rows) {
+    uint32_t id_rows = idma_tile_zero_2d(idma_matrix_addr(dst, rows, 0), pcols * dst->elem, pitch, prows - rows);
+    if (id_rows)
+      id = id_rows;
+  }
+
+  return id;
+}
+
+// Gathers a block and pads it to multiples of (row_align, col_align), returns the last ID
+static inline uint32_t idma_tile_get_padded(const idma_matrix_t *src, uint32_t row, uint32_t col,
+                                            uint32_t rows, uint32_t cols, const idma_matrix_t *dst,
+                                            uint32_t row_align, uint32_t col_align) {
+  uint32_t prows = idma_tile_round_up(rows, row_align);
+  uint32_t pcols = idma_tile_round_up(cols, col_align);
+  uint32_t id    = idma_tile_get(src, row, col, rows, cols, dst);
+  uint32_t id_z  = idma_tile_zero_pad(dst, rows, cols, prows, pcols);
+
+  return id_z ? id_z : id;
+}
+
+#endif // IDMA_TILE_UTILS_H
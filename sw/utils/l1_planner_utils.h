@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA L1 Buffer Planner
+ * Places buffers accessed concurrently by RedMulE, the iDMA and the core so that
+ * their streams start on disjoint L1 banks
+ */
+
+#ifndef L1_PLANNER_UTILS_H
+#define L1_PLANNER_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+
+//=============================================================================
+// Configuration
+//=============================================================================
+// L1 is word-interleaved over NUM_L1_BANKS banks. Streams of the same kind move in
+// lockstep through consecutive banks, so the bank distance between their current
+// accesses stays the one between their first words: placing the first words of
+// concurrent streams on disjoint banks avoids most of the conflicts between them.
+
+#define L1_BANK_BYTES  (BITS_WORD/BITS_BYTE)
+#define L1_ROW_BYTES   (NUM_L1_BANKS*L1_BANK_BYTES)  // One word in every bank
+#define L1_HWPE_BANKS  (17)                          // 544-bit RedMulE port (DWH in magia_tile_pkg.sv)
+
+typedef enum {
+  L1_ACCESS_CORE = 0,  // 32-bit accesses from the core
+  L1_ACCESS_DMA  = 1,  // 32-bit sequential stream from one iDMA channel
+  L1_ACCESS_HWPE = 2   // Wide RedMulE accesses, L1_HWPE_BANKS banks each
+} l1_access_t;
+
+// Buffers only contend for banks when they are accessed at the same time: each one
+// lists the phases (concurrency groups) it is live in, and only pairs sharing a phase count
+#define L1_PHASE(p)   (1u << (p))
+#define L1_PHASE_ALL  (0xFFFFFFFF)
+
+typedef struct {
+  const char  *name;
+  uint32_t     size;    // Bytes
+  l1_access_t  access;
+  uint32_t     phases;  // L1_PHASE() mask of the phases the buffer is accessed in
+  uint32_t     addr;    // Filled in by l1_plan
+} l1_buf_t;
+
+static inline uint32_t l1_bank_of(uint32_t addr) {
+  return (addr / L1_BANK_BYTES) % NUM_L1_BANKS;
+}
+
+static inline uint32_t l1_access_banks(l1_access_t access) {
+  return (access == L1_ACCESS_HWPE) ? L1_HWPE_BANKS : 1;
+}
+
+//=============================================================================
+// Planning
+//=============================================================================
+
+// Banks shared by the first accesses of two buffers
+static inline uint32_t l1_pair_overlap(const l1_buf_t *a, const l1_buf_t *b) {
+  uint32_t a_start = l1_bank_of(a->addr), a_banks = l1_access_banks(a->access);
+  uint32_t b_start = l1_bank_of(b->addr), b_banks = l1_access_banks(b->access);
+  uint32_t overlap = 0;
+
+  for (uint32_t i = 0; i < a_banks; i++) {
+    uint32_t dist = (a_start + i + NUM_L1_BANKS - b_start) % NUM_L1_BANKS;
+    if (dist < b_banks)
+      overlap++;
+  }
+
+  return overlap;
+}
+
+static inline uint32_t l1_pair_concurrent(const l1_buf_t *a, const l1_buf_t *b) {
+  return (a->phases & b->phases) != 0;
+}
+
+// Static conflict estimate of a placement: banks shared by every pair of buffers live in the same phase
+static inline uint32_t l1_plan_conflicts(const l1_buf_t *bufs, uint32_t num_bufs) {
+  uint32_t conflicts = 0;
+
+  for (uint32_t i = 0; i < num_bufs; i++)
+    for (uint32_t j = i + 1; j < num_bufs; j++)
+      if (l1_pair_concurrent(&bufs[i], &bufs[j]))
+        conflicts += l1_pair_overlap(&bufs[i], &bufs[j]);
+
+  return conflicts;
+}
+
+// Places the buffers in order from base, each shifted by up to one bank row so that
+// its first access shares the fewest banks with the buffers already placed that are
+// live in one of its phases. Returns
+// the first free address, 0 if the buffers do not fit below limit.
+static inline uint32_t l1_plan(l1_buf_t *bufs, uint32_t num_bufs, uint32_t base, uint32_t limit) {
+  uint32_t cur = (base + L1_BANK_BYTES - 1) & ~(L1_BANK_BYTES - 1);
+
+  for (uint32_t i = 0; i < num_bufs; i++) {
+    uint32_t best_pad  = 0;
+    uint32_t best_cost = 0xFFFFFFFF;
+
+    for (uint32_t pad = 0; pad < NUM_L1_BANKS && best_cost; pad++) {
+      uint32_t cost = 0;
+      bufs[i].addr = cur + pad*L1_BANK_BYTES;
+      for (uint32_t j = 0; j < i; j++)
+        if (l1_pair_concurrent(&bufs[i], &bufs[j]))
+          cost += l1_pair_overlap(&bufs[i], &bufs[j]);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_pad  = pad;
+      }
+    }
+
+    bufs[i].addr = cur + best_pad*L1_BANK_BYTES;
+
+    cur = (bufs[i].addr + bufs[i].size + L1_BANK_BYTES - 1) & ~(L1_BANK_BYTES - 1);
+    if (cur > limit)
+      return 0;
+  }
+
+  return cur;
+}
+
+static inline uint32_t l1_plan_addr(const l1_buf_t *bufs, uint32_t num_bufs, const char *name) {
+  for (uint32_t i = 0; i < num_bufs; i++) {
+    const char *a = bufs[i].name, *b = name;
+    while (*a && *a == *b) { a++; b++; }
+    if (*a == *b)
+      return bufs[i].addr;
+  }
+  return 0;
+}
+
+static inline void l1_plan_print(const l1_buf_t *bufs, uint32_t num_bufs) {
+  for (uint32_t i = 0; i < num_bufs; i++)
+    printf("%s: 0x%0x (%0d B, bank %0d)\n", bufs[i].name, bufs[i].addr, bufs[i].size, l1_bank_of(bufs[i].addr));
+}
+
+#endif // L1_PLANNER_UTILS_H
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Multi-Core Tile utilities
+ * Intra-tile barrier, tile lock and static work sharing across the NUM_CORES cores
+ *
+ * The iDMA, RedMulE and FSync of the Tile are shared by its cores, and the helpers
+ * driving them (idma_*, redmule_*, hwpe_*, fsync_*) write several registers per job:
+ * call them from core 0 only, or from any core under magia_tile_lock().
+ */
+
+#ifndef MAGIA_CORES_UTILS_H
+#define MAGIA_CORES_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "event_unit_utils.h"
+
+//=============================================================================
+// Configuration
+//=============================================================================
+
+// HW barrier 0 is programmed by crt0 to span all the cores of the Tile
+#define CORES_BARRIER_ID   (0)
+#define CORES_ALL_MASK     ((1 << NUM_CORES) - 1)
+
+typedef void (*magia_parallel_fn_t)(uint32_t idx, void *args);
+
+//=============================================================================
+// Synchronization
+//=============================================================================
+
+static inline void magia_cores_barrier(void) {
+#if NUM_CORES > 1
+    eu_barrier_wait(CORES_BARRIER_ID, EU_WAIT_MODE_WFE);
+#endif
+}
+
+// Spin lock on TILE_PRIV_LOCK. AMOs take the single L1 port of the OBI XBAR while plain
+// accesses take the core's own port: the lock word is released with an AMO too.
+static inline void magia_tile_lock(void) {
+#if NUM_CORES > 1
+    uint32_t old;
+    do {
+        asm volatile("amoswap.w.aq %0, %2, (%1)" : "=r"(old) : "r"(TILE_PRIV_LOCK), "r"(1) : "memory");
+    } while (old);
+#endif
+}
+
+static inline void magia_tile_unlock(void) {
+#if NUM_CORES > 1
+    asm volatile("amoswap.w.rl x0, x0, (%0)" :: "r"(TILE_PRIV_LOCK) : "memory");
+#endif
+}
+
+// Single owner of the shared accelerators, when the other cores do not lock
+static inline int magia_is_core0(void) {
+    return get_coreid() == 0;
+}
+
+//=============================================================================
+// Work Sharing
+//=============================================================================
+
+// Static chunking of [start, end): the first (n % NUM_CORES) cores take one extra iteration
+static inline void magia_parallel_range(uint32_t start, uint32_t end, uint32_t *chunk_start, uint32_t *chunk_end) {
+    uint32_t coreid = get_coreid();
+    uint32_t n      = (end > start) ? (end - start) : 0;
+    uint32_t chunk  = n / NUM_CORES;
+    uint32_t rem    = n % NUM_CORES;
+    uint32_t offset = coreid * chunk + ((coreid < rem) ? coreid : rem);
+
+    *chunk_start = start + offset;
+    *chunk_end   = *chunk_start + chunk + ((coreid < rem) ? 1 : 0);
+}
+
+// Every core of the Tile must call it with the same arguments. body may use the iDMA,
+// RedMulE or FSync helpers only under magia_tile_lock().
+static inline void magia_parallel_for(uint32_t start, uint32_t end, magia_parallel_fn_t body, void *args) {
+    uint32_t cs, ce;
+    magia_parallel_range(start, end, &cs, &ce);
+    for (uint32_t i = cs; i < ce; i++)
+        body(i, args);
+    magia_cores_barrier();
+}
+
+#endif // MAGIA_CORES_UTILS_H
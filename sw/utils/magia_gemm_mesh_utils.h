@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Distributed GEMM
+ * One Z = X*W + Y over the whole mesh: Z is split in a 2D grid of blocks matching
+ * the tiles, each tile computes its block from L2 with magia_gemm
+ */
+
+#ifndef MAGIA_GEMM_MESH_UTILS_H
+#define MAGIA_GEMM_MESH_UTILS_H
+
+#include <stdint.h>
+#include "magia_utils.h"
+#include "magia_gemm_utils.h"
+#include "fsync_mm_utils.h"
+#include "fsync_mm_api.h"
+
+//=============================================================================
+// Partitioning
+//=============================================================================
+// Tile (y, x) of the mesh owns rows [y*M/MESH_Y_TILES, (y+1)*M/MESH_Y_TILES) and
+// columns [x*K/MESH_X_TILES, (x+1)*K/MESH_X_TILES) of Z. It reads the matching row
+// slice of X (shared along its mesh row) and column slice of W (shared along its mesh
+// column) from L2, and writes its block of Z in place: the full Z is gathered in L2.
+
+typedef struct {
+  uint32_t row, rows;  // Block of Z, in elements
+  uint32_t col, cols;
+} magia_gemm_block_t;
+
+static inline void magia_gemm_mesh_block(magia_gemm_block_t *b, uint32_t tile, uint32_t m, uint32_t k) {
+  uint32_t y = GET_Y_ID(tile), x = GET_X_ID(tile);
+
+  b->row  = y*m/MESH_Y_TILES;
+  b->rows = (y + 1)*m/MESH_Y_TILES - b->row;
+  b->col  = x*k/MESH_X_TILES;
+  b->cols = (x + 1)*k/MESH_X_TILES - b->col;
+}
+
+// The block of the calling tile alone, no synchronization
+static inline int magia_gemm_mesh_local(uint32_t x, uint32_t w, uint32_t y, uint32_t z,
+                                        uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  magia_gemm_block_t b;
+  uint32_t es = magia_gemm_elem_bytes(fmt);
+  uint32_t yz;
+
+  magia_gemm_mesh_block(&b, get_hartid(), m, k);
+  yz = (b.row*k + b.col)*es;
+
+  return magia_gemm_ld(x + b.row*n*es, n, w + b.col*es, k, y ? y + yz : 0, z + yz, k,
+                       b.rows, n, b.cols, fmt);
+}
+
+//=============================================================================
+// Distributed GEMM
+//=============================================================================
+// Called by every tile with the same arguments (SPMD). Phases are separated by global
+// FractalSync barriers: inputs written by any tile are visible before the loads start,
+// and the whole of Z is in L2 when the call returns. Returns the status of the local block.
+
+static inline int magia_gemm_mesh(uint32_t x, uint32_t w, uint32_t y, uint32_t z,
+                                  uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  int ret;
+
+  fsync_mm_global();
+  ret = magia_gemm_mesh_local(x, w, y, z, m, n, k, fmt);
+  fsync_mm_global();
+
+  return ret;
+}
+
+#endif // MAGIA_GEMM_MESH_UTILS_H
@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA Tiled GEMM
+ * Z = X*W + Y on matrices of any size outside of L1: the iDMA streams tiles of the
+ * operands into L1 while RedMulE works on the previous ones
+ */
+
+#ifndef MAGIA_GEMM_UTILS_H
+#define MAGIA_GEMM_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+#include "redmule_mm_utils.h"
+#include "redmule_queue_utils.h"
+#include "redmule_fmt_utils.h"
+#include "l1_planner_utils.h"
+#include "magia_mem_utils.h"
+
+//=============================================================================
+// Configuration
+//=============================================================================
+// X is MxN, W is NxK, Y and Z are MxK, all row-major. Z is computed one TILE_M x TILE_K
+// block at a time: the block of Y is loaded in L1 and RedMulE accumulates into it the
+// products of the TILE_N-wide slices of X and W, so the partial sums over N go through
+// its Y input. The workspace is at the same offset from L1_BASE on every tile.
+
+#ifndef MAGIA_GEMM_TILE_M
+#define MAGIA_GEMM_TILE_M (64)
+#endif
+#ifndef MAGIA_GEMM_TILE_N
+#define MAGIA_GEMM_TILE_N (64)
+#endif
+#ifndef MAGIA_GEMM_TILE_K
+#define MAGIA_GEMM_TILE_K (64)
+#endif
+
+#ifndef MAGIA_GEMM_L1_OFFSET
+#define MAGIA_GEMM_L1_OFFSET (0x00040000)
+#endif
+#ifndef MAGIA_GEMM_L1_SIZE
+#define MAGIA_GEMM_L1_SIZE   (0x00040000)
+#endif
+
+#ifndef MAGIA_GEMM_WAIT_MODE
+#define MAGIA_GEMM_WAIT_MODE EU_WAIT_MODE_WFE
+#endif
+
+#define MAGIA_GEMM_OK       (0)
+#define MAGIA_GEMM_NO_SPACE (-1)
+
+static inline uint32_t magia_gemm_elem_bytes(uint8_t fmt) {
+  return redmule_fmt_bytes(fmt);
+}
+
+//=============================================================================
+// Workspace
+//=============================================================================
+// Two sets of X/W tiles (one loading while RedMulE reads the other) and two
+// accumulators (one loading Y or storing Z while RedMulE writes the other).
+
+enum { GEMM_BUF_X0 = 0, GEMM_BUF_W0, GEMM_BUF_X1, GEMM_BUF_W1, GEMM_BUF_ACC0, GEMM_BUF_ACC1, GEMM_NUM_BUFS };
+
+static const char *magia_gemm_buf_names[GEMM_NUM_BUFS] = {"X0", "W0", "X1", "W1", "ACC0", "ACC1"};
+
+static inline uint32_t magia_gemm_plan(l1_buf_t *bufs, uint32_t es) {
+  uint32_t base = idma_local_l1_addr(MAGIA_GEMM_L1_OFFSET);
+
+  // RedMulE works on one set while the iDMA fills the other: all six are live at once
+  for (uint32_t i = 0; i < GEMM_NUM_BUFS; i++) {
+    bufs[i].name   = magia_gemm_buf_names[i];
+    bufs[i].access = L1_ACCESS_HWPE;
+    bufs[i].phases = L1_PHASE_ALL;
+  }
+  bufs[GEMM_BUF_X0].size   = bufs[GEMM_BUF_X1].size   = MAGIA_GEMM_TILE_M*MAGIA_GEMM_TILE_N*es;
+  bufs[GEMM_BUF_W0].size   = bufs[GEMM_BUF_W1].size   = MAGIA_GEMM_TILE_N*MAGIA_GEMM_TILE_K*es;
+  bufs[GEMM_BUF_ACC0].size = bufs[GEMM_BUF_ACC1].size = MAGIA_GEMM_TILE_M*MAGIA_GEMM_TILE_K*es;
+
+  return l1_plan(bufs, GEMM_NUM_BUFS, base, base + MAGIA_GEMM_L1_SIZE);
+}
+
+//=============================================================================
+// Tile Moves
+//=============================================================================
+// A tile is a 2D job: rows x cols elements of a matrix with ld elements per row,
+// packed in L1. Edge tiles are just smaller.
+
+static inline uint32_t magia_gemm_load(uint32_t l1, uint32_t mat, uint32_t ld, uint32_t row, uint32_t col,
+                                       uint32_t rows, uint32_t cols, uint32_t es) {
+  return idma_mm_submit_dir(IDMA_DIR_L2_TO_L1, 0, l1, mat + (row*ld + col)*es, cols*es,
+                            cols*es, ld*es, rows, 0, 0, 1);
+}
+
+static inline uint32_t magia_gemm_store(uint32_t mat, uint32_t l1, uint32_t ld, uint32_t row, uint32_t col,
+                                        uint32_t rows, uint32_t cols, uint32_t es) {
+  return idma_mm_submit_dir(IDMA_DIR_L1_TO_L2, 0, mat + (row*ld + col)*es, l1, cols*es,
+                            ld*es, cols*es, rows, 0, 0, 1);
+}
+
+static inline void magia_gemm_wait(uint32_t is_l1_to_l2, uint32_t id) {
+  while (id && !idma_mm_id_retired_dir(is_l1_to_l2, 0, id))
+    ;
+}
+
+static inline uint32_t magia_gemm_min(uint32_t a, uint32_t b) {
+  return (a < b) ? a : b;
+}
+
+//=============================================================================
+// GEMM
+//=============================================================================
+// Steps go over the Z blocks in row-major order and, within a block, over the slices
+// of N. Step s is queued on RedMulE while step s-1 runs, then the operands of step s+1
+// (and the Y block, when s+1 opens a new block) are loaded while step s runs.
+// y == 0 stands for Y = 0; z may be y.
+// Returns MAGIA_GEMM_NO_SPACE if the workspace does not fit the tiles.
+// magia_gemm_ld works on submatrices: ld_x, ld_w and ld_yz are the row lengths, in
+// elements, of the matrices that hold X, W and Y/Z.
+
+typedef struct {
+  uint32_t blk, first, last;  // Z block, first/last slice of N in it
+  uint32_t row, col, slice;   // Element offsets of the block and of the slice
+  uint32_t tm, tn, tk;        // Tile sizes, smaller on the edges
+  uint32_t set, acc;          // X/W set and accumulator in the workspace
+} magia_gemm_step_t;
+
+static inline void magia_gemm_step(magia_gemm_step_t *st, uint32_t s, uint32_t m, uint32_t n, uint32_t k,
+                                   uint32_t tiles_n, uint32_t tiles_k) {
+  uint32_t ni = s % tiles_n;
+
+  st->blk   = s / tiles_n;
+  st->first = (ni == 0);
+  st->last  = (ni == tiles_n - 1);
+  st->row   = (st->blk / tiles_k) * MAGIA_GEMM_TILE_M;
+  st->col   = (st->blk % tiles_k) * MAGIA_GEMM_TILE_K;
+  st->slice = ni * MAGIA_GEMM_TILE_N;
+  st->tm    = magia_gemm_min(MAGIA_GEMM_TILE_M, m - st->row);
+  st->tn    = magia_gemm_min(MAGIA_GEMM_TILE_N, n - st->slice);
+  st->tk    = magia_gemm_min(MAGIA_GEMM_TILE_K, k - st->col);
+  st->set   = s % 2;
+  st->acc   = st->blk % 2;
+}
+
+// Loads the operands of a step, returns the ID of the last load
+static inline uint32_t magia_gemm_load_step(const magia_gemm_step_t *st, const l1_buf_t *bufs,
+                                            uint32_t x, uint32_t ld_x, uint32_t w, uint32_t ld_w,
+                                            uint32_t y, uint32_t ld_yz, uint32_t es) {
+  uint32_t acc = bufs[GEMM_BUF_ACC0 + st->acc].addr;
+
+  if (st->first) {
+    if (y)
+      magia_gemm_load(acc, y, ld_yz, st->row, st->col, st->tm, st->tk, es);
+    else
+      magia_memset_core(acc, 0, st->tm*st->tk*es);
+  }
+  magia_gemm_load(bufs[GEMM_BUF_X0 + 2*st->set].addr, x, ld_x, st->row, st->slice, st->tm, st->tn, es);
+  return magia_gemm_load(bufs[GEMM_BUF_W0 + 2*st->set].addr, w, ld_w, st->slice, st->col, st->tn, st->tk, es);
+}
+
+static inline int magia_gemm_ld(uint32_t x, uint32_t ld_x, uint32_t w, uint32_t ld_w,
+                                uint32_t y, uint32_t z, uint32_t ld_yz,
+                                uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  l1_buf_t bufs[GEMM_NUM_BUFS];
+  redmule_queue_t q;
+  magia_gemm_step_t st, prev;
+  uint32_t es = magia_gemm_elem_bytes(fmt);
+  uint32_t tiles_m = (m + MAGIA_GEMM_TILE_M - 1) / MAGIA_GEMM_TILE_M;
+  uint32_t tiles_n = (n + MAGIA_GEMM_TILE_N - 1) / MAGIA_GEMM_TILE_N;
+  uint32_t tiles_k = (k + MAGIA_GEMM_TILE_K - 1) / MAGIA_GEMM_TILE_K;
+  uint32_t num_steps = tiles_m*tiles_n*tiles_k;
+  uint32_t load_id, ticket = 0, prev_ticket;
+  uint32_t store_id[2];  // Z store of each accumulator
+
+  if (!num_steps)
+    return MAGIA_GEMM_OK;
+  if (!magia_gemm_plan(bufs, es))
+    return MAGIA_GEMM_NO_SPACE;
+
+  store_id[0] = store_id[1] = 0;
+
+  redmule_queue_init(&q, MAGIA_GEMM_WAIT_MODE);
+
+  magia_gemm_step(&st, 0, m, n, k, tiles_n, tiles_k);
+  load_id = magia_gemm_load_step(&st, bufs, x, ld_x, w, ld_w, y, ld_yz, es);
+
+  for (uint32_t s = 0; s < num_steps; s++) {
+    // Queue step s behind step s-1: jobs retire in order, the W load covers the ones before it
+    magia_gemm_wait(IDMA_DIR_L2_TO_L1, load_id);
+    prev_ticket = ticket;
+    ticket = redmule_queue_push(&q, bufs[GEMM_BUF_X0 + 2*st.set].addr, bufs[GEMM_BUF_W0 + 2*st.set].addr,
+                                bufs[GEMM_BUF_ACC0 + st.acc].addr, st.tm, st.tn, st.tk, fmt);
+
+    // Step s-1 frees its X/W set and, if it closed its block, its accumulator
+    if (s > 0) {
+      redmule_queue_wait(&q, prev_ticket);
+      if (prev.last)
+        store_id[prev.acc] = magia_gemm_store(z, bufs[GEMM_BUF_ACC0 + prev.acc].addr, ld_yz,
+                                              prev.row, prev.col, prev.tm, prev.tk, es);
+    }
+
+    prev = st;
+    if (s + 1 < num_steps) {
+      magia_gemm_step(&st, s + 1, m, n, k, tiles_n, tiles_k);
+      if (st.first)
+        magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[st.acc]);
+      load_id = magia_gemm_load_step(&st, bufs, x, ld_x, w, ld_w, y, ld_yz, es);
+    }
+  }
+
+  redmule_queue_drain(&q);
+  store_id[prev.acc] = magia_gemm_store(z, bufs[GEMM_BUF_ACC0 + prev.acc].addr, ld_yz,
+                                        prev.row, prev.col, prev.tm, prev.tk, es);
+
+  magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[0]);
+  magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[1]);
+
+  return MAGIA_GEMM_OK;
+}
+
+static inline int magia_gemm(uint32_t x, uint32_t w, uint32_t y, uint32_t z,
+                             uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  return magia_gemm_ld(x, n, w, k, y, z, k, m, n, k, fmt);
+}
+
+//=============================================================================
+// Batched GEMM
+//=============================================================================
+// Many GEMMs of the same shape, each small enough to sit in L1 whole (e.g. attention
+// heads). GEMM i is loaded into the X/W/ACC set i % 2 while GEMM i-1 runs from the
+// other set, and is queued on RedMulE right behind it. A W already in its set (same
+// pointer, e.g. a stride of 0) is not loaded again. y == 0 stands for Y = 0. The six
+// buffers are placed by l1_plan, so the streams of the two sets start on disjoint banks.
+
+typedef struct {
+  uint32_t x, w, y, z;
+} magia_gemm_ptrs_t;
+
+// A batch is either an array of operand pointers or a base and a stride for each operand
+typedef struct {
+  const magia_gemm_ptrs_t *ops;  // 0 for the strided form
+  magia_gemm_ptrs_t        base;
+  magia_gemm_ptrs_t        stride;
+} magia_gemm_batch_t;
+
+static inline void magia_gemm_batch_op(const magia_gemm_batch_t *b, uint32_t i, magia_gemm_ptrs_t *op) {
+  if (b->ops) {
+    op->x = b->ops[i].x;
+    op->w = b->ops[i].w;
+    op->y = b->ops[i].y;
+    op->z = b->ops[i].z;
+  } else {
+    op->x = b->base.x + i*b->stride.x;
+    op->w = b->base.w + i*b->stride.w;
+    op->y = b->base.y ? b->base.y + i*b->stride.y : 0;
+    op->z = b->base.z + i*b->stride.z;
+  }
+}
+
+static inline uint32_t magia_gemm_plan_batched(l1_buf_t *bufs, uint32_t m, uint32_t n, uint32_t k, uint32_t es) {
+  uint32_t base = idma_local_l1_addr(MAGIA_GEMM_L1_OFFSET);
+
+  // RedMulE works on one set while the iDMA fills the other: all six are live at once
+  for (uint32_t i = 0; i < GEMM_NUM_BUFS; i++) {
+    bufs[i].name   = magia_gemm_buf_names[i];
+    bufs[i].access = L1_ACCESS_HWPE;
+    bufs[i].phases = L1_PHASE_ALL;
+  }
+  bufs[GEMM_BUF_X0].size   = bufs[GEMM_BUF_X1].size   = m*n*es;
+  bufs[GEMM_BUF_W0].size   = bufs[GEMM_BUF_W1].size   = n*k*es;
+  bufs[GEMM_BUF_ACC0].size = bufs[GEMM_BUF_ACC1].size = m*k*es;
+
+  return l1_plan(bufs, GEMM_NUM_BUFS, base, base + MAGIA_GEMM_L1_SIZE);
+}
+
+// Loads X and W of one GEMM into a set, returns the ID of the last load
+static inline uint32_t magia_gemm_load_xw(const magia_gemm_ptrs_t *op, const l1_buf_t *bufs, uint32_t set,
+                                          uint32_t *w_loaded, uint32_t m, uint32_t n, uint32_t k, uint32_t es) {
+  uint32_t id = idma_L2ToL1_large(op->x, bufs[GEMM_BUF_X0 + 2*set].addr, m*n*es);
+
+  if (w_loaded[set] != op->w) {
+    id = idma_L2ToL1_large(op->w, bufs[GEMM_BUF_W0 + 2*set].addr, n*k*es);
+    w_loaded[set] = op->w;
+  }
+  return id;
+}
+
+// Loads Y into the accumulator of a set, returns the ID of the load (0 if zeroed by the core)
+static inline uint32_t magia_gemm_load_acc(const magia_gemm_ptrs_t *op, const l1_buf_t *bufs, uint32_t set,
+                                           uint32_t m, uint32_t k, uint32_t es) {
+  if (op->y)
+    return idma_L2ToL1_large(op->y, bufs[GEMM_BUF_ACC0 + set].addr, m*k*es);
+  magia_memset_core(bufs[GEMM_BUF_ACC0 + set].addr, 0, m*k*es);
+  return 0;
+}
+
+static inline int magia_gemm_batch_run(const magia_gemm_batch_t *b, uint32_t batch,
+                                       uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  l1_buf_t bufs[GEMM_NUM_BUFS];
+  redmule_queue_t q;
+  magia_gemm_ptrs_t op, prev;
+  uint32_t es = magia_gemm_elem_bytes(fmt);
+  uint32_t load_id, acc_id, ticket = 0, prev_ticket;
+  uint32_t store_id[2], w_loaded[2];
+
+  if (!batch)
+    return MAGIA_GEMM_OK;
+  if ((m > 0xFFFF) || (n > 0xFFFF) || (k > 0xFFFF) || !magia_gemm_plan_batched(bufs, m, n, k, es))
+    return MAGIA_GEMM_NO_SPACE;
+
+  store_id[0] = store_id[1] = 0;
+  w_loaded[0] = w_loaded[1] = 0;
+
+  redmule_queue_init(&q, MAGIA_GEMM_WAIT_MODE);
+
+  magia_gemm_batch_op(b, 0, &op);
+  load_id = magia_gemm_load_xw(&op, bufs, 0, w_loaded, m, n, k, es);
+  acc_id  = magia_gemm_load_acc(&op, bufs, 0, m, k, es);
+  if (acc_id)
+    load_id = acc_id;
+
+  for (uint32_t i = 0; i < batch; i++) {
+    uint32_t set = i % 2;
+
+    // Jobs retire in order: the last load covers the others of the set
+    magia_gemm_wait(IDMA_DIR_L2_TO_L1, load_id);
+    prev_ticket = ticket;
+    ticket = redmule_queue_push(&q, bufs[GEMM_BUF_X0 + 2*set].addr, bufs[GEMM_BUF_W0 + 2*set].addr,
+                                bufs[GEMM_BUF_ACC0 + set].addr, m, n, k, fmt);
+
+    // GEMM i-1 frees the other set: store its Z, then load GEMM i+1 in its place
+    if (i > 0) {
+      redmule_queue_wait(&q, prev_ticket);
+      store_id[1 - set] = idma_L1ToL2_large(bufs[GEMM_BUF_ACC0 + 1 - set].addr, prev.z, m*k*es);
+    }
+    prev = op;
+    if (i + 1 < batch) {
+      magia_gemm_batch_op(b, i + 1, &op);
+      load_id = magia_gemm_load_xw(&op, bufs, 1 - set, w_loaded, m, n, k, es);
+      magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[1 - set]);
+      acc_id  = magia_gemm_load_acc(&op, bufs, 1 - set, m, k, es);
+      if (acc_id)
+        load_id = acc_id;
+    }
+  }
+
+  redmule_queue_drain(&q);
+  store_id[(batch - 1) % 2] = idma_L1ToL2_large(bufs[GEMM_BUF_ACC0 + (batch - 1) % 2].addr, prev.z, m*k*es);
+
+  magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[0]);
+  magia_gemm_wait(IDMA_DIR_L1_TO_L2, store_id[1]);
+
+  return MAGIA_GEMM_OK;
+}
+
+// Operands of GEMM i at ops[i]
+static inline int magia_gemm_batched(const magia_gemm_ptrs_t *ops, uint32_t batch,
+                                     uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  magia_gemm_batch_t b;
+
+  b.ops = ops;
+  return magia_gemm_batch_run(&b, batch, m, n, k, fmt);
+}
+
+// Operands of GEMM i at x + i*stride_x, w + i*stride_w, ... (strides in bytes, 0 shares the operand)
+static inline int magia_gemm_batched_strided(uint32_t x, uint32_t stride_x, uint32_t w, uint32_t stride_w,
+                                             uint32_t y, uint32_t stride_y, uint32_t z, uint32_t stride_z,
+                                             uint32_t batch, uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  magia_gemm_batch_t b;
+
+  b.ops      = 0;
+  b.base.x   = x;
+  b.base.w   = w;
+  b.base.y   = y;
+  b.base.z   = z;
+  b.stride.x = stride_x;
+  b.stride.w = stride_w;
+  b.stride.y = stride_y;
+  b.stride.z = stride_z;
+  return magia_gemm_batch_run(&b, batch, m, n, k, fmt);
+}
+
+#endif // MAGIA_GEMM_UTILS_H
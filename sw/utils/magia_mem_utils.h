@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA memcpy/memset
+ * Replacements for the libc calls that move the data with the core or with the
+ * iDMA, depending on the size and on the memories involved
+ */
+
+#ifndef MAGIA_MEM_UTILS_H
+#define MAGIA_MEM_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "magia_utils.h"
+#include "idma_mm_utils.h"
+#include "idma_rdma_utils.h"
+
+//=============================================================================
+// Memory Regions
+//=============================================================================
+// The iDMA needs the local L1 on one side: its OBI port only reaches the L1 of the
+// tile, its AXI port reaches L2 and the L1 of the other tiles over the NoC. The stack
+// is private to the core. Copies the iDMA cannot do are left to the core.
+
+typedef enum {
+  MAGIA_MEM_LOCAL_L1  = 0,
+  MAGIA_MEM_REMOTE_L1 = 1,
+  MAGIA_MEM_L2        = 2,
+  MAGIA_MEM_CORE_ONLY = 3   // Stack and anything else out of reach of the iDMA
+} magia_mem_region_t;
+
+// Smallest sizes moved by the iDMA, below them the core is faster (see magia_mem_bench_test.c).
+// Far memories stall every core access for the round trip, so the iDMA pays off sooner there.
+#ifndef MAGIA_MEM_DMA_MIN_L1
+#define MAGIA_MEM_DMA_MIN_L1  (256)   // Local L1 to local L1
+#endif
+#ifndef MAGIA_MEM_DMA_MIN_FAR
+#define MAGIA_MEM_DMA_MIN_FAR (32)    // L2 or remote L1 on one side
+#endif
+
+static inline magia_mem_region_t magia_mem_region(uint32_t addr) {
+  uint32_t local = idma_local_l1_addr(0);
+
+  if (addr >= L2_ADDR_START)
+    return MAGIA_MEM_L2;
+  if ((addr >= local) && (addr <= local + L1_SIZE))
+    return MAGIA_MEM_LOCAL_L1;
+  if ((addr >= L1_BASE) && (addr < L1_BASE + NUM_HARTS*L1_TILE_OFFSET))
+    return MAGIA_MEM_REMOTE_L1;
+  return MAGIA_MEM_CORE_ONLY;
+}
+
+//=============================================================================
+// Core Copies
+//=============================================================================
+// Volatile accesses: the compiler would turn plain loops back into memcpy/memset calls,
+// and there is no libc to link them against. Words are used once both sides are aligned.
+
+static inline void magia_memcpy_core(uint32_t dst, uint32_t src, uint32_t len) {
+  uint32_t i = 0;
+
+  if (((dst ^ src) & 0x3) == 0) {
+    for (; (i < len) && ((dst + i) & 0x3); i++)
+      mmio8(dst + i) = mmio8(src + i);
+    for (; i + 4 <= len; i += 4)
+      mmio32(dst + i) = mmio32(src + i);
+  }
+  for (; i < len; i++)
+    mmio8(dst + i) = mmio8(src + i);
+}
+
+static inline void magia_memset_core(uint32_t dst, uint32_t pattern, uint32_t len) {
+  uint32_t i = 0;
+
+  for (; (i < len) && ((dst + i) & 0x3); i++)
+    mmio8(dst + i) = (uint8_t)pattern;
+  for (; i + 4 <= len; i += 4)
+    mmio32(dst + i) = pattern;
+  for (; i < len; i++)
+    mmio8(dst + i) = (uint8_t)pattern;
+}
+
+//=============================================================================
+// Engine Selection
+//=============================================================================
+// Returns the direction the iDMA moves dst <- src on, MAGIA_MEM_USE_CORE if the core
+// does it. A source of 0 stands for a fill, which the iDMA reads from a window of its own.
+
+#define MAGIA_MEM_USE_CORE (0xFFFFFFFF)
+
+static inline uint32_t magia_mem_engine(uint32_t dst, uint32_t src, uint32_t len) {
+  magia_mem_region_t dst_region = magia_mem_region(dst);
+  magia_mem_region_t src_region = src ? magia_mem_region(src) : MAGIA_MEM_LOCAL_L1;
+  uint32_t is_fill = (src == 0);
+  uint32_t min;
+
+  if ((dst_region == MAGIA_MEM_CORE_ONLY) || (src_region == MAGIA_MEM_CORE_ONLY))
+    return MAGIA_MEM_USE_CORE;
+
+  min = ((dst_region == MAGIA_MEM_LOCAL_L1) && (src_region == MAGIA_MEM_LOCAL_L1)) ?
+        MAGIA_MEM_DMA_MIN_L1 : MAGIA_MEM_DMA_MIN_FAR;
+  if (len < min)
+    return MAGIA_MEM_USE_CORE;
+
+  // Into the local L1: AXI2OBI, whatever the source
+  if (dst_region == MAGIA_MEM_LOCAL_L1)
+    return IDMA_DIR_L2_TO_L1;
+  // Out of the local L1 (a fill reads the local L1 window)
+  if (is_fill || (src_region == MAGIA_MEM_LOCAL_L1))
+    return IDMA_DIR_L1_TO_L2;
+  // L2 or remote L1 on both sides: no OBI side for the iDMA
+  return MAGIA_MEM_USE_CORE;
+}
+
+//=============================================================================
+// Asynchronous API
+//=============================================================================
+// A request holds the job to wait for; core copies are over when the call returns.
+// A fill sets the FILL mode of its direction until magia_mem_wait: no other job may be
+// issued on that direction in between, and it waits for the direction to be idle first.
+
+typedef struct {
+  uint32_t dir;   // IDMA_DIR_*, MAGIA_MEM_USE_CORE if done by the core
+  uint32_t id;    // Last iDMA job
+  uint32_t fill;  // Reset the FILL mode once done
+} magia_mem_req_t;
+
+static inline void magia_memcpy_async(magia_mem_req_t *req, void *dst, const void *src, uint32_t len) {
+  uint32_t d = (uint32_t)dst, s = (uint32_t)src;
+
+  req->dir  = magia_mem_engine(d, s, len);
+  req->id   = 0;
+  req->fill = 0;
+
+  if (req->dir == MAGIA_MEM_USE_CORE)
+    magia_memcpy_core(d, s, len);
+  else
+    req->id = idma_memcpy_large_dir(req->dir, s, d, len);
+}
+
+// Sets len bytes at dst to the byte c, as memset
+static inline void magia_memset_async(magia_mem_req_t *req, void *dst, uint8_t c, uint32_t len) {
+  uint32_t d = (uint32_t)dst;
+  uint32_t pattern = c * 0x01010101u;
+
+  req->dir  = magia_mem_engine(d, 0, len);
+  req->id   = 0;
+  req->fill = 0;
+
+  if (req->dir == MAGIA_MEM_USE_CORE) {
+    magia_memset_core(d, pattern, len);
+    return;
+  }
+
+  // The bytes of the pattern are all equal: the realignment of the iDMA leaves it unchanged
+  idma_mm_wait_idle_dir(req->dir);
+  idma_mm_set_xform_dir(req->dir, IDMA_XFORM_FILL, pattern);
+  req->fill = 1;
+  req->id   = idma_fill_submit_dir(req->dir, d,
+                                   (req->dir == IDMA_DIR_L2_TO_L1) ? L2_BASE : idma_local_l1_addr(0), len);
+}
+
+static inline uint32_t magia_mem_done(const magia_mem_req_t *req) {
+  if ((req->dir == MAGIA_MEM_USE_CORE) || (req->id == 0))
+    return 1;
+  return idma_mm_id_retired_dir(req->dir, 0, req->id);
+}
+
+static inline void magia_mem_wait(magia_mem_req_t *req) {
+  while (!magia_mem_done(req)) {
+    wait_nop(1);
+  }
+  if (req->fill) {
+    idma_mm_set_xform_dir(req->dir, IDMA_XFORM_NONE, 0);
+    req->fill = 0;
+  }
+}
+
+//=============================================================================
+// Synchronous API
+//=============================================================================
+
+static inline void *magia_memcpy(void *dst, const void *src, uint32_t len) {
+  magia_mem_req_t req;
+  magia_memcpy_async(&req, dst, src, len);
+  magia_mem_wait(&req);
+  return dst;
+}
+
+static inline void *magia_memset(void *dst, uint8_t c, uint32_t len) {
+  magia_mem_req_t req;
+  magia_memset_async(&req, dst, c, len);
+  magia_mem_wait(&req);
+  return dst;
+}
+
+#endif // MAGIA_MEM_UTILS_H
@@ -45,9 +45,37 @@
 #define L1_BASE        (0x00020000)
 #define L1_SIZE        (0x000DFFFF)
 #define L1_TILE_OFFSET (0x00100000)
+#define L2_ADDR_START  (0xC0000000)
 #define L2_BASE        (0xCC000000)
 #define TEST_END_ADDR  (0xCC030000)
 
+// Cores per Tile - core index in the mhartid LSBs, Tile ID above them
+#ifndef NUM_CORES
+#define NUM_CORES (1)
+#endif
+
+#if NUM_CORES > 4
+#error "MAGIA supports up to 4 cores per Tile"
+#elif NUM_CORES > 2
+#define CORE_ID_BITS (2)
+#elif NUM_CORES > 1
+#define CORE_ID_BITS (1)
+#else
+#define CORE_ID_BITS (0)
+#endif
+#define CORE_ID_MASK ((1 << CORE_ID_BITS) - 1)
+
+#define CORE_STACK_SIZE (0x00001000)
+
+// Tile-private SW state, at the top of the stack region: every tile sees its own copy at
+// the same address, well above the core stacks. .data and .bss are in L2, shared by all
+// the tiles. Zeroed by core 0 of the tile in crt0.S (which mirrors these values).
+#define TILE_PRIV_BASE        (0x0001FF00)
+#define TILE_PRIV_SIZE        (0x00000100)
+#define TILE_PRIV_CORES_READY (TILE_PRIV_BASE + 0x00)  // crt0.S: release of the other cores
+#define TILE_PRIV_LOCK        (TILE_PRIV_BASE + 0x04)  // magia_cores_utils.h: tile lock (AMO accesses only)
+#define TILE_PRIV_IDMA        (TILE_PRIV_BASE + 0x10)  // idma_mm_utils.h: per-tile iDMA state (up to 0x80 B)
+
 #define DEFAULT_EXIT_CODE (0xDEFC)
 #define PASS_EXIT_CODE    (0xAAAA)
 #define FAIL_EXIT_CODE    (0xFFFF)
@@ -76,6 +104,17 @@ void wait_print(unsigned int cycles){
     }
 }
 
+static inline uint32_t get_coreid(){
+#if NUM_CORES > 1
+    uint32_t hartid;
+    asm volatile("csrr %0, mhartid"
+                 :"=r"(hartid):);
+    return hartid & CORE_ID_MASK;
+#else
+    return 0;
+#endif
+}
+
 static inline void irq_en(volatile uint32_t index_oh){
     asm volatile("addi t0, %0, 0\n\t"
                  "csrrs zero, mie, t0"
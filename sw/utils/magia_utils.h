@@ -30,8 +30,14 @@
 #define SYNC_BASE   (RESERVED_START + SYNC_OFFSET)
 #define SYNC_EN     (SYNC_BASE + 0x4)
 
+// Overridable from the command line (e.g. FLAGS="-DMESH_X_TILES=8 -DMESH_Y_TILES=8"),
+// must match N_TILES_X/N_TILES_Y of hw/mesh/magia_pkg.sv
+#ifndef MESH_Y_TILES
 #define MESH_Y_TILES (4)
+#endif
+#ifndef MESH_X_TILES
 #define MESH_X_TILES (4)
+#endif
 #define NUM_HARTS    (MESH_Y_TILES*MESH_X_TILES)
 
 #define GET_Y_ID(mhartid)  ((mhartid)/MESH_X_TILES)
@@ -47,7 +53,7 @@ static inline uint32_t get_hartid(){
     uint32_t hartid;
     asm volatile("csrr %0, mhartid"
                  :"=r"(hartid):);
-    return hartid;
+    return hartid >> CORE_ID_BITS;
 }
 
 static inline void amo_increment(volatile uint32_t addr, volatile uint32_t amnt){
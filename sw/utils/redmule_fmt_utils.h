@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA RedMulE Data Formats
+ * Conversions between the RedMulE formats and FP32 on the core, reference GEMM
+ * and tolerance-aware checks for every format
+ */
+
+#ifndef REDMULE_FMT_UTILS_H
+#define REDMULE_FMT_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "redmule_mm_utils.h"
+
+//=============================================================================
+// Formats
+//=============================================================================
+// IEEE-like layouts (the FPnew ones): an all-ones exponent is infinity or NaN,
+// a zero exponent a subnormal. Conversions round to nearest even.
+//   Float16    - E5M10 (FP16)
+//   Float16Alt - E8M7  (BF16)
+//   Float8     - E5M2
+//   Float8Alt  - E4M3
+
+static inline uint32_t redmule_fmt_bytes(uint8_t fmt) {
+  return ((fmt == Float8) || (fmt == Float8Alt)) ? 1 : 2;
+}
+
+static inline uint32_t redmule_fmt_exp_bits(uint8_t fmt) {
+  switch (fmt) {
+    case Float16Alt: return 8;
+    case Float8Alt:  return 4;
+    default:         return 5;
+  }
+}
+
+static inline uint32_t redmule_fmt_mant_bits(uint8_t fmt) {
+  switch (fmt) {
+    case Float16Alt: return 7;
+    case Float8:     return 2;
+    case Float8Alt:  return 3;
+    default:         return 10;
+  }
+}
+
+static inline const char *redmule_fmt_name(uint8_t fmt) {
+  switch (fmt) {
+    case Float16:    return "FP16";
+    case Float16Alt: return "FP16Alt";
+    case Float8:     return "FP8";
+    case Float8Alt:  return "FP8Alt";
+    default:         return "?";
+  }
+}
+
+// Element i of an array of fmt values at addr
+static inline uint32_t redmule_fmt_load(uint32_t addr, uint32_t i, uint8_t fmt) {
+  return (redmule_fmt_bytes(fmt) == 1) ? mmio8(addr + i) : mmio16(addr + 2*i);
+}
+
+static inline void redmule_fmt_store(uint32_t addr, uint32_t i, uint32_t val, uint8_t fmt) {
+  if (redmule_fmt_bytes(fmt) == 1)
+    mmio8(addr + i) = (uint8_t)val;
+  else
+    mmio16(addr + 2*i) = (uint16_t)val;
+}
+
+//=============================================================================
+// Conversions
+//=============================================================================
+
+typedef union {
+  uint32_t u;
+  float    f;
+} redmule_fp32_t;
+
+// v >> sh rounded to nearest even (sh > 0)
+static inline uint32_t redmule_fmt_rne(uint32_t v, uint32_t sh) {
+  uint32_t q, rem, half;
+
+  if (sh > 31)
+    return 0;
+  q    = v >> sh;
+  rem  = v & ((1u << sh) - 1);
+  half = 1u << (sh - 1);
+  if ((rem > half) || ((rem == half) && (q & 1)))
+    q++;
+  return q;
+}
+
+static inline uint32_t redmule_fp32_to_fmt(uint32_t f, uint8_t fmt) {
+  uint32_t eb = redmule_fmt_exp_bits(fmt), mb = redmule_fmt_mant_bits(fmt);
+  uint32_t s = (f >> 31) << (eb + mb);
+  uint32_t e = (f >> 23) & 0xFF, m = f & 0x7FFFFF;
+  uint32_t e_max = (1u << eb) - 1;
+  int32_t  t = (int32_t)e - 127 + (int32_t)(e_max >> 1);
+
+  if (e == 0xFF)
+    return s | (e_max << mb) | (m ? (1u << (mb - 1)) : 0);
+  if (e == 0)
+    return s;
+  if (t >= (int32_t)e_max)
+    return s | (e_max << mb);
+  // The carry of the rounding moves into the exponent, up to infinity
+  if (t >= 1)
+    return s | redmule_fmt_rne(((uint32_t)t << 23) | m, 23 - mb);
+  return s | redmule_fmt_rne(m | (1u << 23), 23 - mb + 1 - t);
+}
+
+static inline uint32_t redmule_fmt_to_fp32(uint32_t v, uint8_t fmt) {
+  uint32_t eb = redmule_fmt_exp_bits(fmt), mb = redmule_fmt_mant_bits(fmt);
+  uint32_t s = ((v >> (eb + mb)) & 1) << 31;
+  uint32_t e = (v >> mb) & ((1u << eb) - 1), m = v & ((1u << mb) - 1);
+  uint32_t e_max = (1u << eb) - 1;
+  int32_t  u = (int32_t)e - (int32_t)(e_max >> 1);
+
+  if (e == e_max)
+    return s | 0x7F800000 | (m << (23 - mb));
+  if (e == 0) {
+    if (m == 0)
+      return s;
+    // Subnormal: normalize the mantissa
+    u = 1 - (int32_t)(e_max >> 1);
+    while (!(m & (1u << mb))) {
+      m <<= 1;
+      u--;
+    }
+    m &= (1u << mb) - 1;
+  }
+  return s | ((uint32_t)(u + 127) << 23) | (m << (23 - mb));
+}
+
+static inline uint32_t redmule_fmt_convert(uint32_t v, uint8_t src_fmt, uint8_t dst_fmt) {
+  return (src_fmt == dst_fmt) ? v : redmule_fp32_to_fmt(redmule_fmt_to_fp32(v, src_fmt), dst_fmt);
+}
+
+// Converts num values from src_fmt at src to dst_fmt at dst
+static inline void redmule_fmt_convert_array(uint32_t dst, uint8_t dst_fmt, uint32_t src, uint8_t src_fmt, uint32_t num) {
+  for (uint32_t i = 0; i < num; i++)
+    redmule_fmt_store(dst, i, redmule_fmt_convert(redmule_fmt_load(src, i, src_fmt), src_fmt, dst_fmt), dst_fmt);
+}
+
+//=============================================================================
+// Reference and Checks
+//=============================================================================
+
+// z = x*w + y on the core, fmt operands accumulated in FP32 and rounded once to fmt.
+// X is MxN, W is NxK, Y and Z are MxK, row-major; z may be y.
+static inline void redmule_fmt_ref_gemm(uint32_t x, uint32_t w, uint32_t y, uint32_t z,
+                                        uint32_t m, uint32_t n, uint32_t k, uint8_t fmt) {
+  redmule_fp32_t a, b, acc;
+
+  for (uint32_t i = 0; i < m; i++) {
+    for (uint32_t j = 0; j < k; j++) {
+      acc.u = redmule_fmt_to_fp32(redmule_fmt_load(y, i*k + j, fmt), fmt);
+      for (uint32_t l = 0; l < n; l++) {
+        a.u = redmule_fmt_to_fp32(redmule_fmt_load(x, i*n + l, fmt), fmt);
+        b.u = redmule_fmt_to_fp32(redmule_fmt_load(w, l*k + j, fmt), fmt);
+        acc.f += a.f * b.f;
+      }
+      redmule_fmt_store(z, i*k + j, redmule_fp32_to_fmt(acc.u, fmt), fmt);
+    }
+  }
+}
+
+// Distance in units in the last place, across zero too
+static inline uint32_t redmule_fmt_ulp_diff(uint32_t a, uint32_t b, uint8_t fmt) {
+  uint32_t sign = 1u << (redmule_fmt_exp_bits(fmt) + redmule_fmt_mant_bits(fmt));
+  int32_t  oa = (a & sign) ? -(int32_t)(a & (sign - 1)) : (int32_t)(a & (sign - 1));
+  int32_t  ob = (b & sign) ? -(int32_t)(b & (sign - 1)) : (int32_t)(b & (sign - 1));
+
+  return (oa > ob) ? (uint32_t)(oa - ob) : (uint32_t)(ob - oa);
+}
+
+// RedMulE accumulates in its own precision: the tolerance is in ULPs of the output format
+#ifndef REDMULE_FMT_TH_FP16
+#define REDMULE_FMT_TH_FP16     (0x11)
+#endif
+#ifndef REDMULE_FMT_TH_FP16ALT
+#define REDMULE_FMT_TH_FP16ALT  (0x04)
+#endif
+#ifndef REDMULE_FMT_TH_FP8
+#define REDMULE_FMT_TH_FP8      (0x02)
+#endif
+#ifndef REDMULE_FMT_TH_FP8ALT
+#define REDMULE_FMT_TH_FP8ALT   (0x02)
+#endif
+
+static inline uint32_t redmule_fmt_th(uint8_t fmt) {
+  switch (fmt) {
+    case Float16Alt: return REDMULE_FMT_TH_FP16ALT;
+    case Float8:     return REDMULE_FMT_TH_FP8;
+    case Float8Alt:  return REDMULE_FMT_TH_FP8ALT;
+    default:         return REDMULE_FMT_TH_FP16;
+  }
+}
+
+// Returns the values of z further than th ULPs from ref, and the largest distance in max_diff
+static inline uint32_t redmule_fmt_check(uint32_t z, uint32_t ref, uint32_t num, uint8_t fmt,
+                                         uint32_t th, uint32_t *max_diff) {
+  uint32_t num_errors = 0, diff;
+
+  *max_diff = 0;
+  for (uint32_t i = 0; i < num; i++) {
+    diff = redmule_fmt_ulp_diff(redmule_fmt_load(z, i, fmt), redmule_fmt_load(ref, i, fmt), fmt);
+    if (diff > *max_diff)
+      *max_diff = diff;
+    if (diff > th)
+      num_errors++;
+  }
+  return num_errors;
+}
+
+#endif // REDMULE_FMT_UTILS_H
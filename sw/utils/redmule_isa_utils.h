@@ -22,51 +22,65 @@
 #ifndef REDMULE_ISA_UTILS_H
 #define REDMULE_ISA_UTILS_H
 
-/* mcnfig instruction */
-  // asm volatile(
-  //      ".word (0x0       << 25) | \     /* Empty */
-  //             (0b00110   << 20) | \     /* Rs2 - t1 */
-  //             (0b00101   << 15) | \     /* Rs1 - t0 */
-  //             (0x00      <<  7) | \     /* Empty */
-  //             (0b0001011 <<  0)   \n"); /* OpCode */
+/* Instruction encodings
+ * The instructions are emitted with .insn, so the compiler picks the source registers
+ * and the fields are built from compile-time constants.
+ *
+ * mcnfig (custom-0, R-type):
+ *   [31:25] Empty      [24:20] Rs2 - N size       [19:15] Rs1 - K size << 16 | M size
+ *   [14:7]  Empty      [6:0]   OpCode (0b0001011)
+ *
+ * marith (custom-1, R4-type):
+ *   [31:27] Rs3 - Y    [26:25] Empty              [24:20] Rs2 - W      [19:15] Rs1 - X
+ *   [14]    Custom format enable/disable          [13]    Widening enable/disable
+ *   [12:10] Operation selection                   [9:7]   Data format  [6:0] OpCode (0b0101011)
+ *
+ * The bits [14:7] of marith sit on the funct3 and rd fields of the R4 layout.
+ */
+#define REDMULE_MCNFIG_OPCODE (0b0001011)
+#define REDMULE_MARITH_OPCODE (0b0101011)
+
+#define REDMULE_MARITH_FUNCT3(op, widen, custom) ((((custom) & 0x1) << 2) | (((widen) & 0x1) << 1) | (((op) >> 2) & 0x1))
+#define REDMULE_MARITH_RD(op, fmt)               ((((op) & 0x3) << 3) | ((fmt) & 0x7))
+
+/* mcnfig: cfg0 = K size << 16 | M size, cfg1 = N size */
+#define REDMULE_MCNFIG(cfg0, cfg1)                                       \
+  asm volatile(".insn r %0, 0, 0, x0, %1, %2"                            \
+               :: "i"(REDMULE_MCNFIG_OPCODE), "r"(cfg0), "r"(cfg1))
+
+/* marith: Y = X x W + Y. op, fmt, widen and custom must be compile-time constants
+ * (gemm_ops and the formats of redmule_mm_utils.h)
+ */
+#define REDMULE_MARITH(y_base, w_base, x_base, op, fmt, widen, custom)   \
+  asm volatile(".insn r4 %3, %4, 0, x%5, %0, %1, %2"                     \
+               :: "r"(x_base), "r"(w_base), "r"(y_base),                 \
+                  "i"(REDMULE_MARITH_OPCODE),                            \
+                  "i"(REDMULE_MARITH_FUNCT3(op, widen, custom)),         \
+                  "i"(REDMULE_MARITH_RD(op, fmt))                        \
+               : "memory")
+
 static inline void redmule_mcnfig(volatile uint16_t k_size, volatile uint16_t m_size, volatile uint16_t n_size){
   uint32_t cfg_reg0 = (k_size << 16) | (m_size << 0);
   uint32_t cfg_reg1 = n_size << 0;
-  asm volatile("addi t0, %0, 0" ::"r"(cfg_reg0));
-  asm volatile("addi t1, %0, 0" ::"r"(cfg_reg1));
-  asm volatile(
-       ".word (0x0       << 25) | \
-              (0b00110   << 20) | \
-              (0b00101   << 15) | \
-              (0x00      <<  7) | \
-              (0b0001011 <<  0)   \n");
+  REDMULE_MCNFIG(cfg_reg0, cfg_reg1);
+}
+
+/* marith with the data format of redmule_mm_utils.h (Float16, Float16Alt, Float8, Float8Alt)
+ * chosen at run time: prefer REDMULE_MARITH when it is known at compile time
+ */
+static inline void redmule_marith_fmt(volatile uint32_t y_base, volatile uint32_t w_base, volatile uint32_t x_base, uint8_t gemm_fmt){
+  uint32_t y = y_base, w = w_base, x = x_base;
+  switch (gemm_fmt) {
+    case 0x2: REDMULE_MARITH(y, w, x, 0x1, 0x2, 0, 0); break;
+    case 0x3: REDMULE_MARITH(y, w, x, 0x1, 0x3, 0, 0); break;
+    case 0x4: REDMULE_MARITH(y, w, x, 0x1, 0x4, 0, 0); break;
+    default:  REDMULE_MARITH(y, w, x, 0x1, 0x1, 0, 0); break;
+  }
 }
 
-/* marith instruction */
-  // asm volatile(
-  //     ".word (0b00111   << 27) | \     /* Rs3 - t2 */
-  //            (0b00      << 25) | \     /* Empty */
-  //            (0b00110   << 20) | \     /* Rs2 - t1 */
-  //            (0b00101   << 15) | \     /* Rs1 - t0 */
-  //            (0b0       << 14) | \     /* Custom format enable/disable */
-  //            (0b0       << 13) | \     /* Widening enable/disable */
-  //            (0b001     << 10) | \     /* Operation selection */
-  //            (0b001     <<  7) | \     /* Data format */
-  //            (0b0101011 <<  0)   \n"); /* OpCode */
 static inline void redmule_marith(volatile uint32_t y_base, volatile uint32_t w_base, volatile uint32_t x_base){
-  asm volatile("addi t2, %0, 0" ::"r"(y_base));
-  asm volatile("addi t1, %0, 0" ::"r"(w_base));
-  asm volatile("addi t0, %0, 0" ::"r"(x_base));
-  asm volatile(
-       ".word (0b00111   << 27) | \
-              (0b00      << 25) | \
-              (0b00110   << 20) | \
-              (0b00101   << 15) | \
-              (0b0       << 14) | \
-              (0b0       << 13) | \
-              (0b001     << 10) | \
-              (0b001     <<  7) | \
-              (0b0101011 <<  0)   \n");
+  uint32_t y = y_base, w = w_base, x = x_base;
+  REDMULE_MARITH(y, w, x, 0x1, 0x1, 0, 0);
 }
 
 #endif /*REDMULE_ISA_UTILS_H*/
@@ -19,6 +19,8 @@
  * 
  * This header contains MM-related definitions and functions for RedMulE control
  * using MMIO-based register access.
+ * The Tile has one RedMulE: on multi-core Tiles program it from core 0 only, or under
+ * magia_tile_lock() (magia_cores_utils.h).
  */
 
 #ifndef REDMULE_MM_UTILS_H
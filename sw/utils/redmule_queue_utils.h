@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Luca Balboni <luca.balboni10@studio.unibo.it>
+ *
+ * MAGIA RedMulE Job Queue
+ * Keeps the job contexts of hwpe-ctrl full: the next job is programmed while the
+ * current one runs, and jobs are retired through the RedMulE done event
+ */
+
+#ifndef REDMULE_QUEUE_UTILS_H
+#define REDMULE_QUEUE_UTILS_H
+
+#include <stdint.h>
+#include "magia_tile_utils.h"
+#include "redmule_mm_utils.h"
+#include "event_unit_utils.h"
+
+//=============================================================================
+// Queue
+//=============================================================================
+// hwpe-ctrl holds REDMULE_NUM_CONTEXTS jobs: ACQUIRE returns the offload ID of a free
+// context (negative when none is), the jobs run in order and RUNNING_JOB holds the ID
+// of the one in progress. Each pushed job gets a ticket, increasing from 1: a job has
+// retired once hwpe-ctrl is idle or runs a later job.
+
+#define REDMULE_NUM_CONTEXTS (2)  // N_CONTEXT of hwpe-ctrl in RedMulE
+
+typedef struct {
+  uint32_t       issued;   // Ticket of the last job pushed
+  uint32_t       retired;  // Ticket of the last job retired
+  int            offload_id[REDMULE_NUM_CONTEXTS];  // Of ticket t at t % REDMULE_NUM_CONTEXTS
+  eu_wait_mode_t mode;
+} redmule_queue_t;
+
+static inline void redmule_queue_init(redmule_queue_t *q, eu_wait_mode_t mode) {
+  q->issued  = 0;
+  q->retired = 0;
+  q->mode    = mode;
+  hwpe_soft_clear();
+  eu_enable_events(EU_REDMULE_DONE_MASK);
+  eu_clear_events(EU_REDMULE_DONE_MASK);
+}
+
+// Retires the jobs that are over, returns the ticket of the last one
+static inline uint32_t redmule_queue_poll(redmule_queue_t *q) {
+  int running;
+
+  if (q->retired == q->issued)
+    return q->retired;
+
+  if (hwpe_get_status() == 0) {
+    q->retired = q->issued;
+    return q->retired;
+  }
+
+  running = HWPE_READ(REDMULE_RUNNING_JOB);
+  while ((q->retired != q->issued) &&
+         (q->offload_id[(q->retired + 1) % REDMULE_NUM_CONTEXTS] != running))
+    q->retired++;
+
+  return q->retired;
+}
+
+static inline uint32_t redmule_queue_is_retired(redmule_queue_t *q, uint32_t ticket) {
+  return (int32_t)(redmule_queue_poll(q) - ticket) >= 0;
+}
+
+// Sleeps on the done event until the job of ticket has retired
+static inline void redmule_queue_wait(redmule_queue_t *q, uint32_t ticket) {
+  while (!redmule_queue_is_retired(q, ticket))
+    eu_wait_events(EU_REDMULE_DONE_MASK, q->mode, 0);
+}
+
+static inline void redmule_queue_drain(redmule_queue_t *q) {
+  redmule_queue_wait(q, q->issued);
+}
+
+// Programs and triggers one GEMM (z = x*w + z), waiting for a free context if needed.
+// Returns its ticket. The job may start as soon as the previous one ends.
+static inline uint32_t redmule_queue_push(redmule_queue_t *q, uint32_t x, uint32_t w, uint32_t z,
+                                          uint16_t m_size, uint16_t n_size, uint16_t k_size, uint8_t gemm_fmt) {
+  int id;
+
+  if (q->issued - q->retired == REDMULE_NUM_CONTEXTS)
+    redmule_queue_wait(q, q->retired + 1);
+
+  while ((id = hwpe_acquire_job()) < 0)
+    eu_wait_events(EU_REDMULE_DONE_MASK, q->mode, 0);
+
+  redmule_cfg(x, w, z, m_size, n_size, k_size, (uint8_t)gemm_ops, gemm_fmt);
+  hwpe_trigger_job();
+
+  q->issued++;
+  q->offload_id[q->issued % REDMULE_NUM_CONTEXTS] = id;
+
+  return q->issued;
+}
+
+#endif // REDMULE_QUEUE_UTILS_H
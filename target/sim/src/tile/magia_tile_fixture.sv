@@ -161,7 +161,7 @@ module magia_tile_fixture;
   );
   `ifdef CORE_TRACES
     localparam string core_trace_file_name = "log_file_0";
-    defparam i_magia_tile.i_cv32e40x_core.rvfi_i.tracer_i.LOGFILE_PATH_PLUSARG = core_trace_file_name;
+    defparam i_magia_tile.gen_core[0].i_cv32e40x_core.rvfi_i.tracer_i.LOGFILE_PATH_PLUSARG = core_trace_file_name;
   `endif
 
 /*******************************************************/